@@ -1,4 +1,7 @@
 #include "backtracking.h"
+#include "execucao.h"
+#include "propagacao_lote.h"
+#include "paralelo.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,149 +10,75 @@
 #include <time.h>  // Incluindo time.h
 
 
-// Função para verificar se o número é válido na célula
-int is_valid(int grid[SIZE][SIZE], int row, int col, int num) {
-    for (int x = 0; x < SIZE; x++) {
-        if (grid[row][x] == num || grid[x][col] == num) return 0;
-    }
-    int start_row = row - row % 3, start_col = col - col % 3;
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (grid[start_row + i][start_col + j] == num) return 0;
-        }
-    }
-    return 1;
+// Função de backtracking para resolver o Sudoku, em ordem de linha e coluna
+// Antes da busca, a propagação resolve sozinha os Sudokus que não precisam de tentativas
+int solve_sudoku(int grid[SIZE][SIZE], SolveStats *stats) {
+    Search search;
+    search_init(&search, grid, SELECT_ORDER, PROP_SINGLES);
+    int status = search_run(&search, 0);
+    search_stats(&search, stats);
+    return status == SEARCH_SOLVED;
 }
 
-// Função de backtracking para resolver o Sudoku
-int solve_sudoku(int grid[SIZE][SIZE]) {
-    for (int row = 0; row < SIZE; row++) {
-        for (int col = 0; col < SIZE; col++) {
-            if (grid[row][col] == 0) {
-                for (int num = 1; num <= SIZE; num++) {
-                    if (is_valid(grid, row, col, num)) {
-                        grid[row][col] = num;
-                        if (solve_sudoku(grid)) return 1;
-                        grid[row][col] = 0;
-                    }
-                }
-                return 0; // Sem solução
-            }
-        }
-    }
-    return 1; // Solução encontrada
+// Função de resolução do programa no formato dos modos de execução (execucao.h)
+// O nível é fixo (únicos nus e escondidos) e não há segundo método
+static int solve_in_order(int grid[SIZE][SIZE], int level, SolveStats *stats, int *fallback) {
+    (void)level;
+    *fallback = 0;
+    return solve_sudoku(grid, stats);
 }
 
-// Função para carregar múltiplos Sudokus do arquivo
-int load_sudokus(const char *filename, int puzzles[MAX_PUZZLES][SIZE][SIZE]) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        perror("Erro ao abrir arquivo de entrada");
-        exit(EXIT_FAILURE);
-    }
-
-    int puzzle_count = 0;
-    int row = 0;
-    char line[256];
-
-    while (fgets(line, sizeof(line), file)) {
-        // Se linha for vazia, significa troca de puzzle
-        if (strcmp(line, "\n") == 0) {
-            if (row > 0) {
-                puzzle_count++;
-                row = 0;
-            }
-            continue;
-        }
-
-        // Parseia a linha para preencher a matriz
-        for (int col = 0, idx = 0; col < SIZE; col++, idx += 2) {
-            puzzles[puzzle_count][row][col] = (line[idx] == EMPTY) ? 0 : line[idx] - '0';
+// Main
+int main(int argc, char *argv[]) {
+    int batch_mode = 0;
+    int threads = 1;
+    int streaming = 0;
+    int binary_output = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "lj:sb")) != -1) {
+        switch (opt) {
+            case 'l':
+                batch_mode = 1;
+                break;
+            case 'j':
+                threads = atoi(optarg);
+                break;
+            case 's':
+                streaming = 1;
+                break;
+            case 'b':
+                binary_output = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-l | -j <threads> | -s] [-b] <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+                exit(EXIT_FAILURE);
         }
-        row++;
     }
 
-    // Incrementa o contador para o último puzzle lido
-    if (row > 0) puzzle_count++;
-
-    fclose(file);
-    return puzzle_count;
-}
-
-// Função para salvar os Sudokus resolvidos no arquivo
-void save_sudokus(const char *filename, int puzzles[MAX_PUZZLES][SIZE][SIZE], int puzzle_count) {
-    FILE *file = fopen(filename, "w");
-    if (!file) {
-        perror("Erro ao abrir arquivo de saída");
+    if (argc - optind != 2 || threads < 1 || threads > MAX_THREADS || batch_mode + (threads > 1) + streaming > 1) {
+        fprintf(stderr, "Uso: %s [-l | -j <threads> | -s] [-b] <arquivo_entrada> <arquivo_saida>\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    for (int p = 0; p < puzzle_count; p++) {
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (puzzles[p][i][j] == 0) {
-                    fprintf(file, "%c ", EMPTY);
-                } else {
-                    fprintf(file, "%d ", puzzles[p][i][j]);
-                }
-            }
-            fprintf(file, "\n");
-        }
-        if (p < puzzle_count - 1) fprintf(file, "\n");
-    }
-
-    fclose(file);
-}
-
-// Função para medir o tempo de execução
-void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end) {
-    long seconds = end->tv_sec - start->tv_sec;
-    long microseconds = end->tv_usec - start->tv_usec;
-    double elapsed = seconds + microseconds * 1e-6;
-    printf("Tempo de execução (relógio): %.6f segundos\n", elapsed);
-
-    double cpu_time = (double)(cpu_end - cpu_start) / CLOCKS_PER_SEC;
-    printf("Tempo de execução (CPU): %.6f segundos\n", cpu_time);
-}
+    char *input_file = argv[optind];
+    char *output_file = argv[optind + 1];
 
-// Main
-int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida>\n", argv[0]);
-        exit(EXIT_FAILURE);
+    // Os modos -s e -l leem e escrevem o arquivo aos poucos, sem carregar todos os Sudokus
+    if (streaming) {
+        solve_streaming(input_file, output_file, solve_in_order, PROP_SINGLES, binary_output);
+        return 0;
     }
-
-    char *input_file = argv[1];
-    char *output_file = argv[2];
-
-    int puzzles[MAX_PUZZLES][SIZE][SIZE];
-    struct timeval start, end;
-    clock_t cpu_start, cpu_end;
-
-    // Carrega múltiplos Sudokus
-    int puzzle_count = load_sudokus(input_file, puzzles);
-
-    for (int p = 0; p < puzzle_count; p++) {
-        printf("Resolvendo Sudoku #%d...\n", p + 1);
-
-        // Medir tempo de execução de relógio
-        gettimeofday(&start, NULL);
-        cpu_start = clock();
-
-        if (!solve_sudoku(puzzles[p])) {
-            fprintf(stderr, "Sem solução para o Sudoku #%d.\n", p + 1);
-        }
-
-        cpu_end = clock();
-        gettimeofday(&end, NULL);
-
-        // Mostrar tempo
-        measure_time(&start, &end, cpu_start, cpu_end);
+    if (batch_mode) {
+        printf("Resolvendo em lotes de %d...\n", BATCH_LANES);
+        solve_in_batches(input_file, output_file, solve_in_order, PROP_SINGLES, binary_output);
+        printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
+        return 0;
     }
 
-    // Salvar os resultados
-    save_sudokus(output_file, puzzles, puzzle_count);
-
+    // Modo padrão e -j: o arquivo é lido, resolvido e escrito em blocos, com os tempos de cada
+    // Sudoku (-b salva no formato binário)
+    solve_file(input_file, output_file, solve_in_order, PROP_SINGLES, threads, NULL, binary_output);
     printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
 
     return 0;
@@ -3,15 +3,9 @@
 
 #include <sys/time.h>
 #include <time.h>  // Incluindo time.h para usar clock()
+#include "estado.h"
+#include "busca.h"
 
-#define SIZE 15
-#define EMPTY 'v'
-#define MAX_PUZZLES 100
-
-int is_valid(int grid[SIZE][SIZE], int row, int col, int num);
-int solve_sudoku(int grid[SIZE][SIZE]);
-int load_sudokus(const char *filename, int puzzles[MAX_PUZZLES][SIZE][SIZE]);
-void save_sudokus(const char *filename, int puzzles[MAX_PUZZLES][SIZE][SIZE], int puzzle_count);
-void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end);
+int solve_sudoku(int grid[SIZE][SIZE], SolveStats *stats);
 
 #endif
@@ -0,0 +1,304 @@
+#define _GNU_SOURCE // sched_setaffinity
+#include "estado.h"
+#include "busca.h"
+#include "leitura.h"
+#include <limits.h>
+#include <math.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Medição dos motores sobre os arquivos de pastasudokus: cada Sudoku de cada arquivo é resolvido
+// por cada motor várias vezes, depois de algumas execuções de aquecimento que não entram na conta.
+// Cada execução é cronometrada à parte com CLOCK_MONOTONIC, e o resumo (mínimo, mediana, p90, p99,
+// média com intervalo de confiança de 95% e Sudokus por segundo) sai em CSV e em JSON.
+
+#define DEFAULT_RUNS 30
+#define DEFAULT_WARMUP 5
+#define DEFAULT_DIRECTORY "../pastasudokus"
+
+// Arquivos medidos, em ordem de dificuldade
+static const char *const FILES[] = {"facil.txt", "medio.txt", "dificil.txt", "hard.txt"};
+#define FILE_COUNT (int)(sizeof(FILES) / sizeof(FILES[0]))
+
+// Motor medido: estratégia de escolha da célula e nível de propagação
+typedef struct {
+    const char *name;
+    int select;
+    int level;
+} Engine;
+
+static const Engine ENGINES[] = {
+    {"backtracking", SELECT_ORDER, PROP_NONE},
+    {"backtracking-unicos", SELECT_ORDER, PROP_SINGLES},
+    {"mrv", SELECT_MRV, PROP_NONE},
+    {"mrv-unicos", SELECT_MRV, PROP_SINGLES},
+    {"mrv-intersecoes", SELECT_MRV, PROP_INTERSECTIONS},
+    {"mrv-pares", SELECT_MRV, PROP_PAIRS},
+    {"mrv-trincas", SELECT_MRV, PROP_TRIPLES},
+};
+#define ENGINE_COUNT (int)(sizeof(ENGINES) / sizeof(ENGINES[0]))
+
+// Resumo das execuções de um motor em um Sudoku (tempos em segundos)
+typedef struct {
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double mean;
+    double stddev;
+    double ci95;       // metade do intervalo de confiança de 95% da média
+    double rate;       // Sudokus por segundo (1 / média)
+    int status;
+    long nodes;
+} Summary;
+
+// Valores críticos da distribuição t de Student (bicaudal, 95%) para 1 a 30 graus de liberdade
+static const double T_CRITICAL[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+// Função para obter o valor crítico de t com df graus de liberdade
+// Acima de 30 usa a linha tabelada mais próxima abaixo, o que só alarga o intervalo
+static double t_critical(int df) {
+    if (df <= 30) return T_CRITICAL[df - 1];
+    if (df < 40) return 2.042;
+    if (df < 60) return 2.021;
+    if (df < 120) return 2.000;
+    return 1.980;
+}
+
+// Função para calcular a diferença entre dois instantes, em segundos
+static double elapsed(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+// Função para comparar tempos no qsort
+static int compare_times(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Função para obter o percentil p (0-100) de amostras ordenadas pelo método do posto mais próximo
+static double percentile(const double *sorted, int count, double p) {
+    int rank = (int)ceil(p / 100.0 * count);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+// Função para carregar todos os Sudokus de um arquivo; retorna quantos vieram
+static int load_puzzles(const char *filename, int (**puzzles)[SIZE][SIZE]) {
+    PuzzleReader reader;
+    reader_open(&reader, filename);
+
+    int count = 0, capacity = 0;
+    int grid[SIZE][SIZE];
+    *puzzles = NULL;
+    while (reader_next(&reader, grid)) {
+        if (reader.truncated) {
+            fprintf(stderr, "Sudoku #%d incompleto no fim do arquivo: fica fora da medição.\n", count + 1);
+            break;
+        }
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            *puzzles = realloc(*puzzles, capacity * sizeof(**puzzles));
+            if (!*puzzles) {
+                perror("Erro ao alocar os Sudokus");
+                exit(EXIT_FAILURE);
+            }
+        }
+        memcpy((*puzzles)[count++], grid, sizeof(grid));
+    }
+    reader_close(&reader);
+    return count;
+}
+
+// Função para resolver uma vez uma cópia do Sudoku; retorna o tempo em segundos
+static double run_once(const Engine *engine, int puzzle[SIZE][SIZE], long max_nodes, Search *search) {
+    int grid[SIZE][SIZE];
+    memcpy(grid, puzzle, sizeof(grid));
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (search_init(search, grid, engine->select, engine->level) == SEARCH_RUNNING) {
+        search_run(search, max_nodes);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return elapsed(&start, &end);
+}
+
+// Função para medir um motor em um Sudoku: aquecimento, execuções cronometradas e resumo
+static void measure(const Engine *engine, int puzzle[SIZE][SIZE], int runs, int warmup, long max_nodes,
+                    double *samples, Summary *summary) {
+    static Search search; // Grande demais para a pilha
+
+    for (int i = 0; i < warmup; i++) run_once(engine, puzzle, max_nodes, &search);
+    for (int i = 0; i < runs; i++) samples[i] = run_once(engine, puzzle, max_nodes, &search);
+    summary->status = search.status;
+    summary->nodes = search.nodes;
+
+    qsort(samples, runs, sizeof(double), compare_times);
+    double sum = 0;
+    for (int i = 0; i < runs; i++) sum += samples[i];
+    summary->mean = sum / runs;
+
+    double squares = 0;
+    for (int i = 0; i < runs; i++) squares += (samples[i] - summary->mean) * (samples[i] - summary->mean);
+    summary->stddev = runs > 1 ? sqrt(squares / (runs - 1)) : 0;
+    summary->ci95 = runs > 1 ? t_critical(runs - 1) * summary->stddev / sqrt(runs) : 0;
+
+    summary->min = samples[0];
+    summary->median = runs % 2 ? samples[runs / 2] : (samples[runs / 2 - 1] + samples[runs / 2]) / 2;
+    summary->p90 = percentile(samples, runs, 90);
+    summary->p99 = percentile(samples, runs, 99);
+    summary->rate = summary->mean > 0 ? 1.0 / summary->mean : 0;
+}
+
+// Função para descrever a situação final da busca
+static const char *status_name(int status) {
+    if (status == SEARCH_SOLVED) return "resolvido";
+    if (status == SEARCH_FAILED) return "sem-solucao";
+    return "limite";
+}
+
+// Função para fixar o processo em um núcleo
+static void pin_to_core(int core) {
+    if (core >= CPU_SETSIZE) {
+        fprintf(stderr, "Núcleo %d fora do limite (0-%d).\n", core, CPU_SETSIZE - 1);
+        exit(EXIT_FAILURE);
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        perror("Erro ao fixar o processo no núcleo");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Função para abrir um arquivo de resultados
+static FILE *open_report(const char *filename) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        perror("Erro ao abrir arquivo de resultados");
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+// Função para fechar um arquivo de resultados
+static void close_report(FILE *file) {
+    if (fclose(file) != 0) {
+        perror("Erro ao fechar arquivo de resultados");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Função principal
+int main(int argc, char *argv[]) {
+    int runs = DEFAULT_RUNS;
+    int warmup = DEFAULT_WARMUP;
+    int core = -1;
+    long max_nodes = 0;
+    const char *csv_file = "benchmark.csv";
+    const char *json_file = "benchmark.json";
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:w:c:l:o:J:")) != -1) {
+        switch (opt) {
+            case 'n':
+                runs = atoi(optarg);
+                break;
+            case 'w':
+                warmup = atoi(optarg);
+                break;
+            case 'c':
+                core = atoi(optarg);
+                break;
+            case 'l':
+                max_nodes = atol(optarg);
+                break;
+            case 'o':
+                csv_file = optarg;
+                break;
+            case 'J':
+                json_file = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-n <execucoes>] [-w <aquecimento>] [-c <nucleo>] [-l <tentativas>] [-o <arquivo_csv>] [-J <arquivo_json>] [<diretorio>]\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (argc - optind > 1 || runs < 1 || warmup < 0 || max_nodes < 0 || core < -1) {
+        fprintf(stderr, "Uso: %s [-n <execucoes>] [-w <aquecimento>] [-c <nucleo>] [-l <tentativas>] [-o <arquivo_csv>] [-J <arquivo_json>] [<diretorio>]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    const char *directory = optind < argc ? argv[optind] : DEFAULT_DIRECTORY;
+    if (max_nodes == 0) max_nodes = LONG_MAX; // Sem limite de tentativas
+    if (core >= 0) pin_to_core(core);
+
+    struct timespec resolution;
+    clock_getres(CLOCK_MONOTONIC, &resolution);
+
+    double *samples = malloc(runs * sizeof(double));
+    if (!samples) {
+        perror("Erro ao alocar as amostras");
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *csv = open_report(csv_file);
+    FILE *json = open_report(json_file);
+    fprintf(csv, "Arquivo,Sudoku,Motor,Situacao,Nos,Execucoes,Minimo,Mediana,P90,P99,Media,Desvio,IC95,Sudokus por Segundo\n");
+    fprintf(json, "{\n  \"execucoes\": %d,\n  \"aquecimento\": %d,\n  \"nucleo\": ", runs, warmup);
+    if (core >= 0) fprintf(json, "%d", core);
+    else fprintf(json, "null");
+    fprintf(json, ",\n  \"resolucao_relogio_ns\": %ld,\n  \"resultados\": [", resolution.tv_sec * 1000000000L + resolution.tv_nsec);
+
+    int first = 1;
+    for (int f = 0; f < FILE_COUNT; f++) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%s", directory, FILES[f]);
+        int (*puzzles)[SIZE][SIZE];
+        int puzzle_count = load_puzzles(path, &puzzles);
+        printf("%s: %d Sudokus, %d execuções por motor após %d de aquecimento\n", FILES[f], puzzle_count, runs, warmup);
+
+        for (int p = 0; p < puzzle_count; p++) {
+            for (int e = 0; e < ENGINE_COUNT; e++) {
+                Summary s;
+                measure(&ENGINES[e], puzzles[p], runs, warmup, max_nodes, samples, &s);
+
+                printf("  #%d %-20s %-12s mediana %10.2f us  p99 %10.2f us  média %10.2f ± %.2f us  %10.0f Sudokus/s\n",
+                       p + 1, ENGINES[e].name, status_name(s.status), s.median * 1e6, s.p99 * 1e6,
+                       s.mean * 1e6, s.ci95 * 1e6, s.rate);
+
+                fprintf(csv, "%s,%d,%s,%s,%ld,%d,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.1f\n",
+                        FILES[f], p + 1, ENGINES[e].name, status_name(s.status), s.nodes, runs,
+                        s.min, s.median, s.p90, s.p99, s.mean, s.stddev, s.ci95, s.rate);
+
+                fprintf(json, "%s\n    {\"arquivo\": \"%s\", \"sudoku\": %d, \"motor\": \"%s\", \"situacao\": \"%s\", \"nos\": %ld, "
+                              "\"minimo\": %.9f, \"mediana\": %.9f, \"p90\": %.9f, \"p99\": %.9f, \"media\": %.9f, "
+                              "\"desvio\": %.9f, \"ic95\": %.9f, \"sudokus_por_segundo\": %.1f}",
+                        first ? "" : ",", FILES[f], p + 1, ENGINES[e].name, status_name(s.status), s.nodes,
+                        s.min, s.median, s.p90, s.p99, s.mean, s.stddev, s.ci95, s.rate);
+                first = 0;
+            }
+        }
+        free(puzzles);
+    }
+
+    fprintf(json, "\n  ]\n}\n");
+    close_report(csv);
+    close_report(json);
+    free(samples);
+
+    printf("Resultados gravados em %s e %s\n", csv_file, json_file);
+    return 0;
+}
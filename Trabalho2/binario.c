@@ -0,0 +1,112 @@
+#include "binario.h"
+#include "compressao.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Escreve um inteiro de 64 bits em little-endian
+static void put_u64(FILE *file, uint64_t value) {
+    for (int i = 0; i < 8; i++) putc((int)((value >> (8 * i)) & 0xFF), file);
+}
+
+// Função para ler e validar o cabeçalho; retorna 0 se não for um arquivo binário válido
+int binary_parse_header(const unsigned char *data, size_t size, BinaryHeader *header) {
+    if (size < BINARY_HEADER_SIZE || memcmp(data, BINARY_MAGIC, 4) != 0) return 0;
+
+    header->version = data[4];
+    header->size = data[5];
+    header->cell_bits = data[6];
+    header->flags = data[7];
+    header->count = 0;
+    for (int i = 0; i < 8; i++) header->count |= (uint64_t)data[8 + i] << (8 * i);
+
+    if (header->version != BINARY_VERSION || header->size < 1) return 0;
+    if (header->cell_bits != 8 && !(header->cell_bits == 4 && header->size <= 15)) return 0;
+    return 1;
+}
+
+// Função para calcular o tamanho de um Sudoku no arquivo, em bytes
+size_t binary_record_size(const BinaryHeader *header) {
+    size_t cells = (size_t)header->size * header->size;
+    return header->cell_bits == 4 ? (cells + 1) / 2 : cells;
+}
+
+// Função para decodificar um Sudoku 9x9 (o cabeçalho já deve ter sido conferido)
+void binary_decode(const BinaryHeader *header, const unsigned char *record, int grid[SIZE][SIZE]) {
+    int *cells = &grid[0][0];
+    if (header->cell_bits == 4) {
+        for (int k = 0; k < CELLS; k++) cells[k] = (k & 1) ? record[k >> 1] >> 4 : record[k >> 1] & 0x0F;
+    } else {
+        for (int k = 0; k < CELLS; k++) cells[k] = record[k];
+    }
+}
+
+// Função para começar um arquivo binário de Sudokus 9x9
+// O cabeçalho sai com o número de Sudokus desconhecido e é corrigido em binary_writer_finish
+void binary_writer_start(BinaryWriter *writer, FILE *file, int with_index) {
+    writer->file = file;
+    writer->count = 0;
+    writer->with_index = with_index;
+
+    fwrite(BINARY_MAGIC, 1, 4, file);
+    putc(BINARY_VERSION, file);
+    putc(SIZE, file);
+    putc(4, file);
+    putc(0, file);
+    put_u64(file, BINARY_COUNT_UNKNOWN);
+}
+
+// Função para acrescentar um Sudoku, duas células por byte
+// Uma célula fora de 0..SIZE não cabe no registro sem virar outro dígito: o programa é encerrado
+// em vez de gravar um Sudoku corrompido
+void binary_writer_put(BinaryWriter *writer, int grid[SIZE][SIZE]) {
+    const int *cells = &grid[0][0];
+    for (int k = 0; k < CELLS; k++) {
+        if (cells[k] < 0 || cells[k] > SIZE) {
+            fprintf(stderr, "Valor inválido %d na célula (%d, %d) do Sudoku #%llu; o formato binário só guarda de 0 a %d.\n",
+                    cells[k], k / SIZE + 1, k % SIZE + 1, (unsigned long long)writer->count + 1, SIZE);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    unsigned char record[(CELLS + 1) / 2];
+    for (int k = 0; k < CELLS; k += 2) {
+        int high = k + 1 < CELLS ? cells[k + 1] : 0;
+        record[k >> 1] = (unsigned char)(cells[k] | high << 4);
+    }
+    fwrite(record, 1, sizeof(record), writer->file);
+    writer->count++;
+}
+
+// Função para terminar o arquivo: escreve o índice (se pedido) e corrige o cabeçalho
+// Numa saída sem acesso direto (um pipe) o cabeçalho não pode ser corrigido: o número de
+// Sudokus fica desconhecido e o índice é omitido
+void binary_writer_finish(BinaryWriter *writer) {
+    FILE *file = writer->file;
+    int seekable = fseek(file, 0, SEEK_CUR) == 0;
+    int flags = 0;
+
+    if (writer->with_index && seekable) {
+        size_t record = (CELLS + 1) / 2;
+        for (uint64_t i = 0; i < writer->count; i++) put_u64(file, BINARY_HEADER_SIZE + i * record);
+        flags |= BINARY_FLAG_INDEX;
+    } else if (writer->with_index) {
+        fprintf(stderr, "Saída sem acesso direto; o índice do arquivo binário foi omitido.\n");
+    }
+
+    if (seekable && fseek(file, 7, SEEK_SET) == 0) {
+        putc(flags, file);
+        put_u64(file, writer->count);
+        fseek(file, 0, SEEK_END);
+    }
+    fflush(file);
+}
+
+// Função para salvar múltiplos Sudokus no formato binário
+void binary_save(const char *filename, int puzzles[][SIZE][SIZE], int puzzle_count, int with_index) {
+    FILE *file = output_open(filename);
+    BinaryWriter writer;
+    binary_writer_start(&writer, file, with_index);
+    for (int p = 0; p < puzzle_count; p++) binary_writer_put(&writer, puzzles[p]);
+    binary_writer_finish(&writer);
+    output_close(file);
+}
@@ -0,0 +1,48 @@
+#ifndef BINARIO_H
+#define BINARIO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "estado.h"
+
+// Formato binário de Sudokus, versão 1 (inteiros em little-endian):
+//   bytes 0-3   "SDKB"
+//   byte  4     versão (1)
+//   byte  5     ordem da grade (9 para 9x9)
+//   byte  6     bits por célula: 4 (duas células por byte, ordens até 15) ou 8
+//   byte  7     flags: bit 0 = há índice no fim do arquivo
+//   bytes 8-15  número de Sudokus (BINARY_COUNT_UNKNOWN se o arquivo foi escrito sem poder voltar ao início)
+// Seguem os Sudokus, todos com o mesmo tamanho, célula a célula em ordem de linha e coluna
+// (0 = vazia; com 4 bits, a célula par fica na metade baixa do byte). O índice opcional tem
+// o deslocamento de 8 bytes de cada Sudoku, para acesso direto.
+#define BINARY_MAGIC "SDKB"
+#define BINARY_VERSION 1
+#define BINARY_HEADER_SIZE 16
+#define BINARY_FLAG_INDEX 1
+#define BINARY_COUNT_UNKNOWN UINT64_MAX
+
+typedef struct {
+    int version;
+    int size;
+    int cell_bits;
+    int flags;
+    uint64_t count;
+} BinaryHeader;
+
+// Escritor de arquivos binários; o número de Sudokus é corrigido no cabeçalho ao terminar
+typedef struct {
+    FILE *file;
+    uint64_t count;
+    int with_index;
+} BinaryWriter;
+
+int binary_parse_header(const unsigned char *data, size_t size, BinaryHeader *header);
+size_t binary_record_size(const BinaryHeader *header);
+void binary_decode(const BinaryHeader *header, const unsigned char *record, int grid[SIZE][SIZE]);
+
+void binary_writer_start(BinaryWriter *writer, FILE *file, int with_index);
+void binary_writer_put(BinaryWriter *writer, int grid[SIZE][SIZE]);
+void binary_writer_finish(BinaryWriter *writer);
+void binary_save(const char *filename, int puzzles[][SIZE][SIZE], int puzzle_count, int with_index);
+
+#endif
@@ -0,0 +1,118 @@
+#include "busca.h"
+
+// Escolhe a próxima célula vazia segundo a estratégia da busca
+static int choose_cell(const Search *search) {
+    if (search->select == SELECT_MRV) return mrv_best_cell(&search->queue);
+
+    // Em ordem: continua a partir da última célula decidida
+    int pos = search->depth > 0 ? search->stack[search->depth - 1].pos + 1 : 0;
+    while (pos < CELLS && search->state.grid[pos / SIZE][pos % SIZE] != 0) pos++;
+    return pos < CELLS ? pos : NO_CELL;
+}
+
+// Escolhe o próximo dígito a tentar entre os candidatos restantes, segundo a ordem da busca
+static int next_digit(Search *search, Mask remaining) {
+    if (search->order == ORDER_DESCENDING) return (int)(8 * sizeof(Mask)) - __builtin_clz(remaining);
+    if (search->order == ORDER_RANDOM) {
+        // xorshift32: rápido e suficiente para variar a ordem entre as buscas
+        search->seed ^= search->seed << 13;
+        search->seed ^= search->seed >> 17;
+        search->seed ^= search->seed << 5;
+        for (int skip = search->seed % count_bits(remaining); skip > 0; skip--) remaining &= remaining - 1;
+    }
+    return lowest_digit(remaining);
+}
+
+// Função para preparar a busca sobre a grade e aplicar a propagação inicial
+// Retorna a situação da busca (um Sudoku resolvido só por propagação já sai SEARCH_SOLVED)
+int search_init(Search *search, int grid[SIZE][SIZE], int select, int level) {
+    search->trail.len = 0;
+    search->trail.filled = 0;
+    search->depth = 0;
+    search->descend = 1;
+    search->select = select;
+    search->level = level;
+    search->order = ORDER_ASCENDING;
+    search->seed = 1;
+    search->nodes = 0;
+    search->status = SEARCH_RUNNING;
+
+    if (!state_init(&search->state, grid)) {
+        search->status = SEARCH_FAILED;
+        return search->status;
+    }
+    mrv_init(&search->queue, &search->state);
+
+    if (!propagate(&search->queue, &search->trail, level)) {
+        unpropagate(&search->queue, &search->trail, 0);
+        search->status = SEARCH_FAILED;
+    } else if (search->queue.empty_cells == 0) {
+        search->status = SEARCH_SOLVED;
+    }
+    return search->status;
+}
+
+// Função para trocar a ordem em que os candidatos são tentados (padrão: crescente)
+// Deve ser chamada depois de search_init e antes de search_run; a semente só vale para ORDER_RANDOM
+void search_set_order(Search *search, int order, unsigned int seed) {
+    search->order = order;
+    search->seed = seed ? seed : 1; // O xorshift não sai do zero
+}
+
+// Função para avançar a busca até resolver, esgotar as opções ou fazer max_nodes tentativas
+// Com max_nodes == 0 não há limite. Retorna SEARCH_RUNNING se parou pelo limite;
+// chamar de novo retoma exatamente do mesmo ponto
+int search_run(Search *search, long max_nodes) {
+    MrvQueue *queue = &search->queue;
+    Trail *trail = &search->trail;
+    long budget_end = search->nodes + max_nodes;
+
+    while (search->status == SEARCH_RUNNING) {
+        if (search->descend) {
+            int pos = choose_cell(search);
+            if (pos == NO_CELL) {
+                search->status = SEARCH_SOLVED;
+                break;
+            }
+            search->descend = 0;
+            if (queue->count[pos] > 0) {
+                Decision *decision = &search->stack[search->depth++];
+                decision->pos = pos;
+                decision->remaining = state_candidates(&search->state, pos / SIZE, pos % SIZE);
+                decision->mark = trail->len;
+            }
+            // Sem candidatos: volta direto para a próxima opção da decisão anterior
+        }
+
+        if (search->depth == 0) {
+            search->status = SEARCH_FAILED;
+            break;
+        }
+
+        // Desfaz a tentativa anterior desta decisão (e tudo o que veio depois dela)
+        Decision *decision = &search->stack[search->depth - 1];
+        unpropagate(queue, trail, decision->mark);
+        if (!decision->remaining) {
+            search->depth--;
+            continue;
+        }
+
+        if (max_nodes > 0 && search->nodes >= budget_end) break; // Pausa
+
+        int num = next_digit(search, decision->remaining);
+        decision->remaining &= ~DIGIT_BIT(num);
+        search->nodes++;
+        if (trail_place(queue, trail, decision->pos, num) && propagate(queue, trail, search->level)) {
+            search->descend = 1;
+        }
+    }
+
+    if (search->status == SEARCH_FAILED) unpropagate(queue, trail, 0);
+    return search->status;
+}
+
+// Função para copiar as estatísticas da busca
+void search_stats(const Search *search, SolveStats *stats) {
+    stats->filled = search->trail.filled;
+    stats->nodes = search->nodes;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include "propagacao.h"
+
+// Estratégias de escolha da próxima célula
+#define SELECT_MRV 0     // menor número de candidatos
+#define SELECT_ORDER 1   // primeira célula vazia em ordem de linha e coluna
+
+// Ordem em que os candidatos de uma célula são tentados
+#define ORDER_ASCENDING 0    // do menor para o maior dígito
+#define ORDER_DESCENDING 1   // do maior para o menor
+#define ORDER_RANDOM 2       // sorteada a cada decisão, a partir de uma semente
+
+// Situação da busca
+#define SEARCH_RUNNING 0
+#define SEARCH_SOLVED 1
+#define SEARCH_FAILED 2
+
+// Decisão empilhada: célula escolhida, candidatos ainda não tentados e tamanho do rastro antes da tentativa
+typedef struct {
+    int pos;
+    Mask remaining;
+    int mark;
+} Decision;
+
+// Busca iterativa com pilha explícita; todo o estado fica nesta estrutura,
+// então ela pode ser pausada e retomada sem usar a pilha de chamadas
+typedef struct {
+    SudokuState state;
+    MrvQueue queue;
+    Trail trail;
+    Decision stack[CELLS];
+    int depth;
+    int descend;   // 1 se a próxima iteração deve escolher uma nova célula
+    int select;
+    int level;
+    int order;
+    unsigned int seed;   // estado do gerador da ordem aleatória
+    int status;
+    long nodes;
+} Search;
+
+int search_init(Search *search, int grid[SIZE][SIZE], int select, int level);
+void search_set_order(Search *search, int order, unsigned int seed);
+int search_run(Search *search, long max_nodes);
+void search_stats(const Search *search, SolveStats *stats);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,292 @@
+#define _GNU_SOURCE // fopencookie
+#include "compressao.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+// O fluxo comprimido vira um FILE comum (fopencookie): o leitor e as funções de escrita
+// continuam usando getc, fread e fprintf sem saber que há compressão no meio
+typedef struct {
+    FILE *raw;          // arquivo comprimido
+    int format;
+    int writing;
+    int finished;       // 1 se o último quadro comprimido foi até o fim
+    unsigned char buffer[COMPRESS_CHUNK];
+#ifdef USE_ZLIB
+    z_stream zlib;
+#endif
+#ifdef USE_ZSTD
+    ZSTD_DStream *zstd_in;
+    ZSTD_CStream *zstd_out;
+    ZSTD_inBuffer input;
+#endif
+} CompressedStream;
+
+// Função para reconhecer a compressão pelo primeiro byte da entrada
+// O formato de texto só tem 'v', dígitos e espaços, e o binário começa com 'S'
+int compress_detect(int first_byte) {
+    if (first_byte == 0x1f) return COMPRESS_GZIP;
+    if (first_byte == 0x28) return COMPRESS_ZSTD;
+    return COMPRESS_NONE;
+}
+
+// Função para escolher a compressão da saída pela extensão do arquivo
+int compress_from_name(const char *filename) {
+    size_t length = strlen(filename);
+    if (length > 3 && strcmp(filename + length - 3, ".gz") == 0) return COMPRESS_GZIP;
+    if (length > 4 && strcmp(filename + length - 4, ".zst") == 0) return COMPRESS_ZSTD;
+    return COMPRESS_NONE;
+}
+
+// Encerra o programa se o formato não foi compilado
+static void check_support(int format) {
+#ifndef USE_ZLIB
+    if (format == COMPRESS_GZIP) {
+        fprintf(stderr, "Arquivo gzip, mas o programa foi compilado sem a zlib (make ZLIB=1).\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+#ifndef USE_ZSTD
+    if (format == COMPRESS_ZSTD) {
+        fprintf(stderr, "Arquivo zstd, mas o programa foi compilado sem a libzstd (make ZSTD=1).\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    (void)format;
+}
+
+#if defined(USE_ZLIB) || defined(USE_ZSTD)
+// Lê mais um bloco do arquivo comprimido; retorna quantos bytes vieram
+static size_t refill(CompressedStream *stream) {
+    return fread(stream->buffer, 1, COMPRESS_CHUNK, stream->raw);
+}
+#endif
+
+// Descomprime até size bytes; retorna 0 no fim do arquivo
+// Dados corrompidos encerram o programa, como os outros erros de leitura
+static ssize_t stream_read(void *cookie, char *out, size_t size) {
+    CompressedStream *stream = cookie;
+    size_t produced = 0;
+
+#ifdef USE_ZLIB
+    if (stream->format == COMPRESS_GZIP) {
+        z_stream *z = &stream->zlib;
+        z->next_out = (Bytef *)out;
+        z->avail_out = size;
+        while (z->avail_out == size) {
+            if (z->avail_in == 0) {
+                size_t n = refill(stream);
+                if (n == 0) break;
+                z->next_in = stream->buffer;
+                z->avail_in = n;
+            }
+            int status = inflate(z, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                inflateReset(z); // Vários membros gzip concatenados formam um arquivo só
+                stream->finished = 1;
+            } else if (status == Z_OK || status == Z_BUF_ERROR) {
+                stream->finished = 0;
+            } else {
+                fprintf(stderr, "Arquivo gzip corrompido.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        produced = size - z->avail_out;
+    }
+#endif
+#ifdef USE_ZSTD
+    if (stream->format == COMPRESS_ZSTD) {
+        ZSTD_outBuffer output = {out, size, 0};
+        while (output.pos == 0) {
+            if (stream->input.pos == stream->input.size) {
+                size_t n = refill(stream);
+                if (n == 0) break;
+                stream->input.src = stream->buffer;
+                stream->input.size = n;
+                stream->input.pos = 0;
+            }
+            size_t status = ZSTD_decompressStream(stream->zstd_in, &output, &stream->input);
+            if (ZSTD_isError(status)) {
+                fprintf(stderr, "Arquivo zstd corrompido: %s\n", ZSTD_getErrorName(status));
+                exit(EXIT_FAILURE);
+            }
+            stream->finished = status == 0;
+        }
+        produced = output.pos;
+    }
+#endif
+    (void)out;
+    (void)size;
+
+    if (produced == 0 && !stream->finished) {
+        fprintf(stderr, "Arquivo comprimido truncado; o fim dos dados foi ignorado.\n");
+        stream->finished = 1; // Avisa só uma vez
+    }
+    return produced;
+}
+
+// Comprime um pedaço da saída, escrevendo no arquivo cada bloco que ficar pronto
+// Com finish, fecha o quadro comprimido
+static int compress_chunk(CompressedStream *stream, const char *data, size_t size, int finish) {
+#ifdef USE_ZLIB
+    if (stream->format == COMPRESS_GZIP) {
+        z_stream *z = &stream->zlib;
+        z->next_in = (Bytef *)data;
+        z->avail_in = size;
+        int status;
+        do {
+            z->next_out = stream->buffer;
+            z->avail_out = COMPRESS_CHUNK;
+            status = deflate(z, finish ? Z_FINISH : Z_NO_FLUSH);
+            size_t n = COMPRESS_CHUNK - z->avail_out;
+            if (n > 0 && fwrite(stream->buffer, 1, n, stream->raw) != n) return 0;
+        } while (z->avail_in > 0 || (finish && status != Z_STREAM_END));
+    }
+#endif
+#ifdef USE_ZSTD
+    if (stream->format == COMPRESS_ZSTD) {
+        ZSTD_inBuffer input = {data, size, 0};
+        size_t remaining;
+        do {
+            ZSTD_outBuffer output = {stream->buffer, COMPRESS_CHUNK, 0};
+            remaining = ZSTD_compressStream2(stream->zstd_out, &output, &input, finish ? ZSTD_e_end : ZSTD_e_continue);
+            if (ZSTD_isError(remaining)) return 0;
+            if (output.pos > 0 && fwrite(stream->buffer, 1, output.pos, stream->raw) != output.pos) return 0;
+        } while (input.pos < input.size || (finish && remaining != 0));
+    }
+#endif
+    (void)stream;
+    (void)data;
+    (void)size;
+    (void)finish;
+    return 1;
+}
+
+// Comprime size bytes; retorna 0 se a escrita falhar
+static ssize_t stream_write(void *cookie, const char *data, size_t size) {
+    return compress_chunk(cookie, data, size, 0) ? (ssize_t)size : 0;
+}
+
+// Fecha o fluxo: termina a compressão e fecha o arquivo (a entrada e a saída padrão ficam abertas)
+static int stream_close(void *cookie) {
+    CompressedStream *stream = cookie;
+    int ok = 1;
+    if (stream->writing) ok = compress_chunk(stream, NULL, 0, 1);
+
+#ifdef USE_ZLIB
+    if (stream->format == COMPRESS_GZIP) {
+        if (stream->writing) deflateEnd(&stream->zlib);
+        else inflateEnd(&stream->zlib);
+    }
+#endif
+#ifdef USE_ZSTD
+    if (stream->format == COMPRESS_ZSTD) {
+        ZSTD_freeDStream(stream->zstd_in);
+        ZSTD_freeCStream(stream->zstd_out);
+    }
+#endif
+
+    if (stream->raw == stdout) {
+        if (fflush(stream->raw) != 0) ok = 0;
+    } else if (stream->raw != stdin && fclose(stream->raw) != 0) {
+        ok = 0;
+    }
+    free(stream);
+    if (!ok) fprintf(stderr, "Erro ao escrever o arquivo comprimido.\n");
+    return ok ? 0 : EOF;
+}
+
+// Cria o fluxo e prepara o compressor ou o descompressor
+static CompressedStream *stream_create(FILE *raw, int format, int writing) {
+    check_support(format);
+    CompressedStream *stream = calloc(1, sizeof(CompressedStream));
+    if (!stream) {
+        perror("Erro ao alocar o fluxo comprimido");
+        exit(EXIT_FAILURE);
+    }
+    stream->raw = raw;
+    stream->format = format;
+    stream->writing = writing;
+    stream->finished = 1;
+
+    int ok = 1;
+#ifdef USE_ZLIB
+    if (format == COMPRESS_GZIP) {
+        // 15 + 16: janela máxima com cabeçalho gzip; 15 + 32 aceita gzip e zlib na leitura
+        ok = writing ? deflateInit2(&stream->zlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK
+                     : inflateInit2(&stream->zlib, 15 + 32) == Z_OK;
+    }
+#endif
+#ifdef USE_ZSTD
+    if (format == COMPRESS_ZSTD) {
+        if (writing) {
+            stream->zstd_out = ZSTD_createCStream();
+            ok = stream->zstd_out != NULL;
+        } else {
+            stream->zstd_in = ZSTD_createDStream();
+            ok = stream->zstd_in != NULL && !ZSTD_isError(ZSTD_initDStream(stream->zstd_in));
+        }
+    }
+#endif
+    if (!ok) {
+        fprintf(stderr, "Erro ao iniciar a compressão.\n");
+        exit(EXIT_FAILURE);
+    }
+    return stream;
+}
+
+// Função para ler um arquivo comprimido como um FILE comum; fechar o FILE fecha raw também
+FILE *compress_reader(FILE *raw, int format) {
+    cookie_io_functions_t functions = {stream_read, NULL, NULL, stream_close};
+    FILE *file = fopencookie(stream_create(raw, format, 0), "r", functions);
+    if (!file) {
+        perror("Erro ao abrir arquivo comprimido");
+        exit(EXIT_FAILURE);
+    }
+    setvbuf(file, NULL, _IOFBF, COMPRESS_CHUNK);
+    return file;
+}
+
+// Função para escrever um arquivo comprimido como um FILE comum
+// A compressão termina no fclose; o arquivo não tem acesso direto (fseek falha)
+FILE *compress_writer(FILE *raw, int format) {
+    cookie_io_functions_t functions = {NULL, stream_write, NULL, stream_close};
+    FILE *file = fopencookie(stream_create(raw, format, 1), "w", functions);
+    if (!file) {
+        perror("Erro ao abrir arquivo comprimido");
+        exit(EXIT_FAILURE);
+    }
+    setvbuf(file, NULL, _IOFBF, COMPRESS_CHUNK);
+    return file;
+}
+
+// Função para abrir o arquivo de saída; "-" é a saída padrão
+// Arquivos terminados em .gz ou .zst são comprimidos enquanto são escritos
+FILE *output_open(const char *filename) {
+    if (strcmp(filename, "-") == 0) return stdout;
+
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        perror("Erro ao abrir arquivo de saída");
+        exit(EXIT_FAILURE);
+    }
+    int format = compress_from_name(filename);
+    return format == COMPRESS_NONE ? file : compress_writer(file, format);
+}
+
+// Função para fechar o arquivo de saída (a saída padrão só é esvaziada)
+void output_close(FILE *file) {
+    if (file == stdout) {
+        fflush(file);
+    } else if (fclose(file) != 0) {
+        perror("Erro ao fechar arquivo de saída");
+        exit(EXIT_FAILURE);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef COMPRESSAO_H
+#define COMPRESSAO_H
+
+#include <stdio.h>
+
+// Arquivos de Sudokus comprimidos, lidos e escritos aos poucos, sem arquivos temporários.
+// A entrada é reconhecida pelo primeiro byte (gzip começa com 0x1f, zstd com 0x28) e a saída
+// pela extensão (.gz ou .zst). O gzip usa a zlib e o zstd a libzstd; cada uma pode ser
+// desligada ou ligada no makefile (ZLIB=0, ZSTD=1).
+#define COMPRESS_NONE 0
+#define COMPRESS_GZIP 1
+#define COMPRESS_ZSTD 2
+
+// Tamanho dos blocos lidos do arquivo comprimido e entregues ao compressor
+#define COMPRESS_CHUNK (1 << 16)
+
+int compress_detect(int first_byte);
+int compress_from_name(const char *filename);
+FILE *compress_reader(FILE *raw, int format);
+FILE *compress_writer(FILE *raw, int format);
+
+FILE *output_open(const char *filename);
+void output_close(FILE *file);
+
+#endif
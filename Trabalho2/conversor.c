@@ -0,0 +1,81 @@
+#include "estado.h"
+#include "leitura.h"
+#include "binario.h"
+#include "compressao.h"
+#include "escrita.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Conversor entre o formato de texto dos Sudokus e o formato binário (binario.h)
+// O formato da entrada é reconhecido pelos primeiros bytes e a saída sai no outro formato
+
+// Função principal
+int main(int argc, char *argv[]) {
+    int with_index = 0;
+    long only = 0; // Sudoku a extrair, contando do 1 (0 = todos)
+    int opt;
+
+    while ((opt = getopt(argc, argv, "in:")) != -1) {
+        switch (opt) {
+            case 'i':
+                with_index = 1;
+                break;
+            case 'n':
+                only = atol(optarg);
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-i] [-n <sudoku>] <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (argc - optind != 2 || only < 0) {
+        fprintf(stderr, "Uso: %s [-i] [-n <sudoku>] <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    char *input_file = argv[optind];
+    char *output_file = argv[optind + 1];
+
+    PuzzleReader reader;
+    reader_open(&reader, input_file);
+    int to_binary = !reader.binary;
+    if (with_index && !to_binary) {
+        fprintf(stderr, "A opção -i só vale para a saída binária.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // -n pula direto para o Sudoku pedido (pelo índice, se a entrada binária tiver um)
+    if (only > 0 && !reader_seek(&reader, (uint64_t)(only - 1))) {
+        fprintf(stderr, "O arquivo não tem o Sudoku #%ld.\n", only);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *output = output_open(output_file);
+
+    TextWriter text;
+    BinaryWriter binary;
+    if (to_binary) binary_writer_start(&binary, output, with_index);
+    else text_writer_start(&text, output);
+
+    int grid[SIZE][SIZE];
+    long count = 0;
+    while ((only == 0 || count < 1) && reader_next(&reader, grid)) {
+        if (reader.truncated) {
+            fprintf(stderr, "Sudoku #%ld incompleto no fim do arquivo: convertido com as células que faltam vazias.\n",
+                    count + 1);
+        }
+        if (to_binary) binary_writer_put(&binary, grid);
+        else text_writer_put(&text, grid);
+        count++;
+    }
+    if (to_binary) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+
+    reader_close(&reader);
+    output_close(output);
+
+    fprintf(stderr, "%ld Sudokus convertidos para o formato %s.\n", count, to_binary ? "binário" : "de texto");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "escrita.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Texto de cada valor de 0 a 9, dois bytes por célula: "v " para a vazia e "d " para os dígitos
+static const char CELL_TEXT[] = "v 1 2 3 4 5 6 7 8 9 ";
+
+// Escreve o bloco acumulado e esvazia o buffer
+static void flush_block(TextWriter *writer) {
+    const char *data = writer->buffer;
+    size_t left = writer->used;
+
+    if (writer->fd < 0) {
+        if (fwrite(data, 1, left, writer->file) != left) {
+            perror("Erro ao escrever arquivo de saída");
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        while (left > 0) {
+            ssize_t n = write(writer->fd, data, left);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                perror("Erro ao escrever arquivo de saída");
+                exit(EXIT_FAILURE);
+            }
+            data += n;
+            left -= n;
+        }
+    }
+    writer->used = 0;
+}
+
+// Função para começar a escrever Sudokus em texto no arquivo
+// O que o stdio ainda tem guardado sai antes, para os blocos não passarem na frente
+void text_writer_start(TextWriter *writer, FILE *file) {
+    writer->file = file;
+    writer->fd = fileno(file);
+    writer->used = 0;
+    writer->count = 0;
+    writer->buffer = malloc(OUTPUT_BUFFER);
+    if (!writer->buffer) {
+        perror("Erro ao alocar o buffer de saída");
+        exit(EXIT_FAILURE);
+    }
+    fflush(file);
+}
+
+// Função para formatar um Sudoku em out; retorna quantos bytes foram escritos
+// out precisa de PUZZLE_TEXT_MAX bytes; a saída é a mesma de um fprintf("%d ") por célula
+size_t format_sudoku(char *out, int grid[SIZE][SIZE]) {
+    char *start = out;
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            unsigned int value = grid[i][j];
+            if (value <= 9) {
+                memcpy(out, CELL_TEXT + 2 * value, 2);
+                out += 2;
+            } else {
+                out += sprintf(out, "%d ", grid[i][j]); // Valor inválido deixado pela entrada
+            }
+        }
+        *out++ = '\n';
+    }
+    return out - start;
+}
+
+// Função para acrescentar um Sudoku, com uma linha em branco antes se não for o primeiro
+void text_writer_put(TextWriter *writer, int grid[SIZE][SIZE]) {
+    if (OUTPUT_BUFFER - writer->used < PUZZLE_TEXT_MAX) flush_block(writer);
+
+    if (writer->count > 0) writer->buffer[writer->used++] = '\n';
+    writer->used += format_sudoku(writer->buffer + writer->used, grid);
+    writer->count++;
+}
+
+// Função para escrever o que falta e liberar o buffer (o arquivo continua aberto)
+void text_writer_finish(TextWriter *writer) {
+    flush_block(writer);
+    free(writer->buffer);
+    writer->buffer = NULL;
+}
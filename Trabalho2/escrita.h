@@ -0,0 +1,29 @@
+#ifndef ESCRITA_H
+#define ESCRITA_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "estado.h"
+
+// Tamanho do bloco de saída: os Sudokus são formatados nele e escritos com um único write()
+#define OUTPUT_BUFFER (1 << 20)
+// Maior texto de um Sudoku: cada célula fora de 0..9 pode ocupar até 12 bytes ("-2147483648 ")
+#define PUZZLE_TEXT_MAX (CELLS * 12 + SIZE + 2)
+
+// Escritor do formato de texto ('v' ou dígito seguido de espaço, uma linha por linha da grade e
+// uma linha em branco entre Sudokus). O texto é montado em um bloco pré-alocado e sai em blocos
+// grandes direto no descritor do arquivo; numa saída comprimida (sem descritor) sai pelo fwrite.
+typedef struct {
+    FILE *file;
+    int fd;          // -1 se o arquivo não tem descritor próprio
+    char *buffer;
+    size_t used;
+    long count;      // Sudokus escritos, para pôr a linha em branco entre eles
+} TextWriter;
+
+size_t format_sudoku(char *out, int grid[SIZE][SIZE]);
+void text_writer_start(TextWriter *writer, FILE *file);
+void text_writer_put(TextWriter *writer, int grid[SIZE][SIZE]);
+void text_writer_finish(TextWriter *writer);
+
+#endif
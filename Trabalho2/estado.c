@@ -0,0 +1,57 @@
+#include "estado.h"
+
+// Função para montar as máscaras a partir da grade inicial
+// Retorna 0 se a grade tiver valores fora do intervalo ou repetidos
+int state_init(SudokuState *state, int grid[SIZE][SIZE]) {
+    state->grid = grid;
+    for (int i = 0; i < SIZE; i++) {
+        state->rows[i] = state->cols[i] = state->boxes[i] = 0;
+    }
+    for (int pos = 0; pos < CELLS; pos++) state->removed[pos] = 0;
+
+    int ok = 1;
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int num = grid[row][col];
+            if (num == 0) continue;
+            if (num < 1 || num > SIZE) {
+                ok = 0;
+                continue;
+            }
+            Mask bit = DIGIT_BIT(num);
+            if ((state->rows[row] | state->cols[col] | state->boxes[BOX_INDEX(row, col)]) & bit) ok = 0;
+            state->rows[row] |= bit;
+            state->cols[col] |= bit;
+            state->boxes[BOX_INDEX(row, col)] |= bit;
+        }
+    }
+    return ok;
+}
+
+int peers[CELLS][NUM_PEERS];
+int units[NUM_UNITS][SIZE];
+
+// Função para montar as tabelas de vizinhos e unidades (executada só uma vez)
+void init_tables(void) {
+    static int ready = 0;
+    if (ready) return;
+    for (int pos = 0; pos < CELLS; pos++) {
+        int row = pos / SIZE, col = pos % SIZE, n = 0;
+        for (int other = 0; other < CELLS; other++) {
+            int r = other / SIZE, c = other % SIZE;
+            if (other == pos) continue;
+            if (r == row || c == col || BOX_INDEX(r, c) == BOX_INDEX(row, col)) {
+                peers[pos][n++] = other;
+            }
+        }
+    }
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            units[i][j] = i * SIZE + j;
+            units[SIZE + i][j] = j * SIZE + i;
+            units[2 * SIZE + i][j] = ((i / BOX_SIZE) * BOX_SIZE + j / BOX_SIZE) * SIZE
+                                   + (i % BOX_SIZE) * BOX_SIZE + j % BOX_SIZE;
+        }
+    }
+    ready = 1;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef ESTADO_H
+#define ESTADO_H
+
+#define SIZE 9
+#define BOX_SIZE 3
+#define EMPTY 'v'
+#define CELLS (SIZE * SIZE)
+#define NUM_PEERS (3 * (SIZE - 1) - 2 * (BOX_SIZE - 1))
+#define NUM_UNITS (3 * SIZE)
+
+// Máscara de dígitos: o bit (num - 1) representa o dígito num
+typedef unsigned int Mask;
+
+#define ALL_DIGITS ((Mask)((1u << SIZE) - 1))
+#define DIGIT_BIT(num) ((Mask)1u << ((num) - 1))
+#define BOX_INDEX(row, col) (((row) / BOX_SIZE) * BOX_SIZE + (col) / BOX_SIZE)
+
+// Estado do resolvedor: a grade, os dígitos já usados em cada linha, coluna e bloco
+// e os candidatos eliminados de cada célula pela propagação
+typedef struct {
+    int (*grid)[SIZE];
+    Mask rows[SIZE];
+    Mask cols[SIZE];
+    Mask boxes[SIZE];
+    Mask removed[CELLS];
+} SudokuState;
+
+// Vizinhos de cada célula (mesma linha, coluna ou bloco), com posições row * SIZE + col
+extern int peers[CELLS][NUM_PEERS];
+// Células de cada unidade: linhas 0..SIZE-1, colunas SIZE..2*SIZE-1 e blocos 2*SIZE..3*SIZE-1
+extern int units[NUM_UNITS][SIZE];
+
+int state_init(SudokuState *state, int grid[SIZE][SIZE]);
+void init_tables(void);
+
+// Número de bits ligados na máscara
+static inline int count_bits(Mask mask) {
+    return __builtin_popcount(mask);
+}
+
+// Dígito representado pelo bit menos significativo da máscara
+static inline int lowest_digit(Mask mask) {
+    return __builtin_ctz(mask) + 1;
+}
+
+// Dígitos ainda possíveis para a célula
+static inline Mask state_candidates(const SudokuState *state, int row, int col) {
+    return ALL_DIGITS & ~(state->rows[row] | state->cols[col] | state->boxes[BOX_INDEX(row, col)]
+                          | state->removed[row * SIZE + col]);
+}
+
+// Coloca o dígito na célula e marca-o na linha, coluna e bloco
+static inline void state_place(SudokuState *state, int row, int col, int num) {
+    Mask bit = DIGIT_BIT(num);
+    state->grid[row][col] = num;
+    state->rows[row] |= bit;
+    state->cols[col] |= bit;
+    state->boxes[BOX_INDEX(row, col)] |= bit;
+}
+
+// Desfaz a jogada da célula, liberando o dígito na linha, coluna e bloco
+static inline void state_undo(SudokuState *state, int row, int col) {
+    Mask bit = ~DIGIT_BIT(state->grid[row][col]);
+    state->grid[row][col] = 0;
+    state->rows[row] &= bit;
+    state->cols[col] &= bit;
+    state->boxes[BOX_INDEX(row, col)] &= bit;
+}
+
+#endif
\ No newline at end of file
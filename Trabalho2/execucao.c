@@ -0,0 +1,268 @@
+#include "execucao.h"
+#include "propagacao_lote.h"
+#include "leitura.h"
+#include "binario.h"
+#include "compressao.h"
+#include "escrita.h"
+#include "paralelo.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Função para medir o tempo de CPU
+// Os instantes vêm do relógio de CPU da thread (CLOCK_THREAD_CPUTIME_ID), que continua certo
+// quando vários Sudokus são resolvidos ao mesmo tempo; o clock() somaria todas as threads
+double measure_cpu_time(const struct timespec *start, const struct timespec *end) {
+    double elapsed = (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) * 1e-9;
+    printf("Tempo de execução (CPU): %.6f segundos\n", elapsed);
+    return elapsed;
+}
+
+// Função para medir o tempo de relógio
+double measure_wall_time(const struct timeval *start, const struct timeval *end) {
+    long seconds = end->tv_sec - start->tv_sec;
+    long microseconds = end->tv_usec - start->tv_usec;
+    double elapsed = seconds + microseconds * 1e-6;
+    printf("Tempo de execução (relógio): %.6f segundos\n", elapsed);
+    return elapsed;
+}
+
+// Função para mostrar o tempo total de um arquivo e a vazão em Sudokus por segundo
+void print_throughput(FILE *stream, long puzzle_count, struct timeval *start, struct timeval *end) {
+    double seconds = (end->tv_sec - start->tv_sec) + (end->tv_usec - start->tv_usec) * 1e-6;
+    fprintf(stream, "Tempo total (relógio): %.6f segundos, vazão: %.0f Sudokus/s\n", seconds,
+           seconds > 0 ? puzzle_count / seconds : 0.0);
+}
+
+// Função para resolver um Sudoku medindo seus tempos
+// Só escreve na grade e no resultado do próprio Sudoku, então pode rodar em qualquer thread
+// Quando há segundo método, os tempos incluem as duas tentativas: é o custo real do Sudoku
+void solve_puzzle(int p, void *context) {
+    SolveJob *job = context;
+    PuzzleResult *result = &job->results[p];
+
+    gettimeofday(&result->wall_start, NULL);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &result->cpu_start);
+    result->solved = job->solve(job->puzzles[p], job->level, &result->stats, &result->fallback);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &result->cpu_end);
+    gettimeofday(&result->wall_end, NULL);
+}
+
+// Função para avisar que o Sudoku p (contado a partir de 0) acabou no meio da grade
+// Ele não é resolvido: as células que faltam não foram dadas, e completá-las daria um Sudoku que
+// não está no arquivo. Sai como foi lido, na mesma posição, e conta como sem solução
+void report_truncated(long p) {
+    fprintf(stderr, "Sudoku #%ld incompleto no fim do arquivo: não foi resolvido e sai com as células que faltam vazias.\n", p + 1);
+}
+
+// Função para mostrar o resultado de um Sudoku e gravar sua linha no CSV (se houver)
+void report_puzzle(long p, const PuzzleResult *result, int level, FILE *csv) {
+    const char *method = "MRV";
+    if (result->fallback) {
+        printf("Heurística falhou para Sudoku #%ld, tentando backtracking...\n", p + 1);
+        method = "Backtracking";
+    }
+
+    if (!result->solved) {
+        fprintf(stderr, "Sem solução para o Sudoku #%ld.\n", p + 1);
+        return;
+    }
+
+    double cpu_time = measure_cpu_time(&result->cpu_start, &result->cpu_end);
+    double wall_time = measure_wall_time(&result->wall_start, &result->wall_end);
+    printf("Células preenchidas por propagação: %ld, tentativas: %ld\n", result->stats.filled, result->stats.nodes);
+    if (csv) {
+        fprintf(csv, "%ld,%s,%d,%.6f,%.6f,%ld,%ld\n", p + 1, method, level, cpu_time, wall_time,
+                result->stats.filled, result->stats.nodes);
+    }
+}
+
+// Função para resolver o arquivo mostrando os tempos de cada Sudoku (modo padrão e opção -j)
+// Os Sudokus são lidos em blocos de SOLVE_CHUNK, resolvidos (por threads threads, distribuídos
+// pelo parallel_for), mostrados na ordem da entrada e escritos antes do próximo bloco; assim
+// arquivos de qualquer tamanho são resolvidos inteiros com memória limitada
+void solve_file(const char *input_file, const char *output_file, SolveFunction solve, int level,
+                int threads, FILE *csv, int binary_output) {
+    int (*puzzles)[SIZE][SIZE] = malloc(SOLVE_CHUNK * sizeof(*puzzles));
+    PuzzleResult *results = malloc(SOLVE_CHUNK * sizeof(PuzzleResult));
+    if (!puzzles || !results) {
+        perror("Erro ao alocar os Sudokus");
+        exit(EXIT_FAILURE);
+    }
+    SolveJob job = {puzzles, results, solve, level};
+
+    PuzzleReader reader;
+    reader_open(&reader, input_file);
+    FILE *output = output_open(output_file);
+
+    TextWriter text;
+    BinaryWriter binary;
+    if (binary_output) binary_writer_start(&binary, output, 0);
+    else text_writer_start(&text, output);
+
+    // As tabelas de vizinhos são montadas antes de criar as threads
+    if (threads > 1) {
+        init_tables();
+        printf("Resolvendo com %d threads...\n", threads);
+    }
+
+    long total = 0;
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+
+    for (;;) {
+        int count = 0;
+        while (count < SOLVE_CHUNK && reader_next(&reader, puzzles[count])) count++;
+        if (count == 0) break;
+        int complete = reader.truncated ? count - 1 : count; // O incompleto é sempre o último
+
+        if (threads == 1) {
+            for (int p = 0; p < complete; p++) {
+                printf("Resolvendo Sudoku #%ld...\n", total + p + 1);
+                solve_puzzle(p, &job);
+                report_puzzle(total + p, &results[p], level, csv);
+            }
+        } else {
+            parallel_for(complete, threads, solve_puzzle, &job);
+            for (int p = 0; p < complete; p++) {
+                printf("Resolvendo Sudoku #%ld...\n", total + p + 1);
+                report_puzzle(total + p, &results[p], level, csv);
+            }
+        }
+        if (complete < count) report_truncated(total + complete);
+
+        for (int p = 0; p < count; p++) {
+            if (binary_output) binary_writer_put(&binary, puzzles[p]);
+            else text_writer_put(&text, puzzles[p]);
+        }
+        total += count;
+    }
+    if (binary_output) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+    gettimeofday(&end, NULL);
+
+    reader_close(&reader);
+    output_close(output);
+    print_throughput(stdout, total, &start, &end);
+
+    free(puzzles);
+    free(results);
+}
+
+// Função para resolver o arquivo em lotes de BATCH_LANES (opção -l)
+// Cada lote é lido da entrada, propagado de uma vez e escrito antes de ler o próximo, então
+// a memória não depende do tamanho do arquivo. A propagação em lote resolve os Sudokus que não
+// precisam de tentativas; os demais seguem para a função de resolução do programa, já com as
+// células determinadas preenchidas. Sudokus sem solução saem como foram lidos
+void solve_in_batches(const char *input_file, const char *output_file, SolveFunction solve, int level, int binary_output) {
+    static LaneBatch batch;
+    static int puzzles[BATCH_LANES][SIZE][SIZE];
+    static int work[BATCH_LANES][SIZE][SIZE];
+    SolveStats stats;
+    int fallback;
+    long total = 0;
+    int by_propagation = 0, by_search = 0, unsolved = 0;
+
+    PuzzleReader reader;
+    reader_open(&reader, input_file);
+    FILE *output = output_open(output_file);
+
+    TextWriter text;
+    BinaryWriter binary;
+    if (binary_output) binary_writer_start(&binary, output, 0);
+    else text_writer_start(&text, output);
+
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+
+    for (;;) {
+        int count = 0;
+        while (count < BATCH_LANES && reader_next(&reader, puzzles[count])) count++;
+        if (count == 0) break;
+        int complete = reader.truncated ? count - 1 : count; // O incompleto fica fora do lote
+
+        memcpy(work, puzzles, count * sizeof(work[0]));
+        lanes_load(&batch, work, complete);
+        lanes_propagate(&batch);
+        lanes_extract(&batch, work);
+
+        for (int lane = 0; lane < count; lane++) {
+            int solved = 0;
+            if (lane == complete) {
+                report_truncated(total + lane);
+                unsolved++;
+            } else if (!(batch.failed & LANE_BIT(lane))) {
+                if (batch.solved & LANE_BIT(lane)) {
+                    solved = 1;
+                    by_propagation++;
+                } else if (solve(work[lane], level, &stats, &fallback)) {
+                    solved = 1;
+                    by_search++;
+                }
+            }
+
+            if (!solved && lane < complete) {
+                fprintf(stderr, "Sem solução para o Sudoku #%ld.\n", total + lane + 1);
+                unsolved++;
+            }
+            int (*result)[SIZE] = solved ? work[lane] : puzzles[lane];
+            if (binary_output) binary_writer_put(&binary, result);
+            else text_writer_put(&text, result);
+        }
+        total += count;
+    }
+    if (binary_output) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+    gettimeofday(&end, NULL);
+
+    reader_close(&reader);
+    output_close(output);
+
+    printf("Resolvidos pela propagação em lote: %d, com busca: %d, sem solução: %d\n",
+           by_propagation, by_search, unsolved);
+    print_throughput(stdout, total, &start, &end);
+}
+
+// Função para resolver um Sudoku por vez, lendo o próximo só depois de escrever o atual (opção -s)
+// A memória não depende do tamanho da entrada; "-" no lugar de um arquivo usa a entrada ou a
+// saída padrão, e as mensagens vão para a saída de erro para não se misturarem às grades
+// Com binary_output a saída sai no formato binário (binario.h)
+void solve_streaming(const char *input_file, const char *output_file, SolveFunction solve, int level, int binary_output) {
+    PuzzleReader reader;
+    reader_open(&reader, input_file);
+    FILE *output = output_open(output_file);
+
+    TextWriter text;
+    BinaryWriter binary;
+    if (binary_output) binary_writer_start(&binary, output, 0);
+    else text_writer_start(&text, output);
+
+    int grid[SIZE][SIZE];
+    SolveStats stats;
+    int fallback;
+    long count = 0;
+    int unsolved = 0;
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+
+    while (reader_next(&reader, grid)) {
+        if (reader.truncated) {
+            report_truncated(count);
+            unsolved++;
+        } else if (!solve(grid, level, &stats, &fallback)) {
+            fprintf(stderr, "Sem solução para o Sudoku #%ld.\n", count + 1);
+            unsolved++;
+        }
+        if (binary_output) binary_writer_put(&binary, grid);
+        else text_writer_put(&text, grid);
+        count++;
+    }
+    if (binary_output) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+    gettimeofday(&end, NULL);
+
+    reader_close(&reader);
+    output_close(output);
+
+    fprintf(stderr, "Resolvidos: %ld, sem solução: %d\n", count - unsolved, unsolved);
+    print_throughput(stderr, count, &start, &end);
+}
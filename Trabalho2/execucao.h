@@ -0,0 +1,50 @@
+#ifndef EXECUCAO_H
+#define EXECUCAO_H
+
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+#include "estado.h"
+#include "busca.h"
+
+// Modos de execução comuns aos programas backtracking e heuristica. Cada programa entrega a
+// sua função de resolução e o nível de propagação; a leitura, a medição dos tempos, os lotes
+// e a escrita do resultado ficam aqui, uma vez só.
+
+// Sudokus lidos de cada vez no modo padrão e no -j; limita a memória sem limitar o arquivo
+#define SOLVE_CHUNK 4096
+
+// Função de resolução de um programa: resolve a grade no lugar e retorna 1 se achou solução
+// fallback recebe 1 quando o método principal falhou e um segundo método foi usado
+typedef int (*SolveFunction)(int grid[SIZE][SIZE], int level, SolveStats *stats, int *fallback);
+
+// Resultado de um Sudoku, guardado pela thread que o resolveu e mostrado depois, na ordem da entrada
+typedef struct {
+    int solved;
+    int fallback;   // 1 se o método principal falhou e o segundo foi usado
+    struct timespec cpu_start, cpu_end;
+    struct timeval wall_start, wall_end;
+    SolveStats stats;
+} PuzzleResult;
+
+// Dados compartilhados pelas threads que resolvem o arquivo
+typedef struct {
+    int (*puzzles)[SIZE][SIZE];
+    PuzzleResult *results;
+    SolveFunction solve;
+    int level;
+} SolveJob;
+
+double measure_cpu_time(const struct timespec *start, const struct timespec *end);
+double measure_wall_time(const struct timeval *start, const struct timeval *end);
+void print_throughput(FILE *stream, long puzzle_count, struct timeval *start, struct timeval *end);
+
+void solve_puzzle(int p, void *context);
+void report_puzzle(long p, const PuzzleResult *result, int level, FILE *csv);
+void report_truncated(long p);
+void solve_file(const char *input_file, const char *output_file, SolveFunction solve, int level,
+                int threads, FILE *csv, int binary_output);
+void solve_in_batches(const char *input_file, const char *output_file, SolveFunction solve, int level, int binary_output);
+void solve_streaming(const char *input_file, const char *output_file, SolveFunction solve, int level, int binary_output);
+
+#endif
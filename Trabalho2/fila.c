@@ -0,0 +1,114 @@
+#include "fila.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// Cada posição começa com sequência igual ao seu índice. Um produtor só escreve na posição pos
+// se a sequência for pos (livre nesta volta) e depois a marca pos + 1; um consumidor só lê se
+// ela for pos + 1 e depois a marca pos + capacidade, liberando-a para a volta seguinte.
+// As posições de escrita e leitura avançam com compare-and-swap, sem travas.
+
+// Função para criar a fila; capacity é arredondada para a próxima potência de 2
+// Retorna 0 se faltar memória
+int queue_init(JobQueue *queue, size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+
+    queue->cells = malloc(size * sizeof(QueueCell));
+    if (!queue->cells) return 0;
+    for (size_t i = 0; i < size; i++) queue->cells[i].sequence = i;
+    queue->mask = size - 1;
+    queue->enqueue_pos = 0;
+    queue->dequeue_pos = 0;
+    queue->waiting = 0;
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+    return 1;
+}
+
+// Função para liberar a fila
+void queue_free(JobQueue *queue) {
+    free(queue->cells);
+    queue->cells = NULL;
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->changed);
+}
+
+// Acorda quem espera na fila depois de uma inserção ou retirada
+// As barreiras dos dois lados garantem que, se a thread que espera ainda não foi contada aqui,
+// a nova tentativa dela já vê a mudança; a espera é feita com a trava, então o aviso não se perde
+static void wake_waiting(JobQueue *queue) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->waiting, __ATOMIC_RELAXED) == 0) return;
+    pthread_mutex_lock(&queue->lock);
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+// Função para inserir sem esperar; retorna 0 se a fila estiver cheia
+int queue_try_push(JobQueue *queue, const PuzzleJob *job) {
+    size_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        QueueCell *cell = &queue->cells[pos & queue->mask];
+        size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->job = *job;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+            // Outro produtor ficou com a posição; pos já foi atualizada pelo compare-and-swap
+        } else if (diff < 0) {
+            return 0; // Cheia: o consumidor ainda não liberou esta posição
+        } else {
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Função para retirar sem esperar; retorna 0 se a fila estiver vazia
+int queue_try_pop(JobQueue *queue, PuzzleJob *job) {
+    size_t pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        QueueCell *cell = &queue->cells[pos & queue->mask];
+        size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->dequeue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *job = cell->job;
+                __atomic_store_n(&cell->sequence, pos + queue->mask + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0; // Vazia
+        } else {
+            pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Função para inserir, dormindo enquanto a fila estiver cheia
+void queue_push(JobQueue *queue, const PuzzleJob *job) {
+    if (!queue_try_push(queue, job)) {
+        pthread_mutex_lock(&queue->lock);
+        __atomic_add_fetch(&queue->waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        while (!queue_try_push(queue, job)) pthread_cond_wait(&queue->changed, &queue->lock);
+        __atomic_sub_fetch(&queue->waiting, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&queue->lock);
+    }
+    wake_waiting(queue);
+}
+
+// Função para retirar, dormindo enquanto a fila estiver vazia
+void queue_pop(JobQueue *queue, PuzzleJob *job) {
+    if (!queue_try_pop(queue, job)) {
+        pthread_mutex_lock(&queue->lock);
+        __atomic_add_fetch(&queue->waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        while (!queue_try_pop(queue, job)) pthread_cond_wait(&queue->changed, &queue->lock);
+        __atomic_sub_fetch(&queue->waiting, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&queue->lock);
+    }
+    wake_waiting(queue);
+}
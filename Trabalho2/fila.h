@@ -0,0 +1,45 @@
+#ifndef FILA_H
+#define FILA_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include "estado.h"
+
+// Sudoku em trânsito entre as etapas da esteira: posição no arquivo, resultado e grade
+typedef struct {
+    long index;   // -1 marca o fim do trabalho
+    int solved;
+    int incomplete;  // 1 se a entrada acabou no meio deste Sudoku: ele passa sem ser resolvido
+    int grid[SIZE][SIZE];
+} PuzzleJob;
+
+// Posição de uma fila: o número de sequência diz se ela está livre ou ocupada na volta atual
+typedef struct {
+    size_t sequence;
+    PuzzleJob job;
+} QueueCell;
+
+// Fila limitada sem travas, para vários produtores e vários consumidores
+// As duas posições ficam em linhas de cache diferentes para produtores e consumidores não disputarem
+// A trava e a condição só são usadas por quem precisa esperar (fila cheia ou vazia)
+typedef struct {
+    QueueCell *cells;
+    size_t mask;
+    char pad0[64];
+    size_t enqueue_pos;
+    char pad1[64];
+    size_t dequeue_pos;
+    char pad2[64];
+    int waiting;             // threads paradas em changed
+    pthread_mutex_t lock;
+    pthread_cond_t changed;  // avisada quando uma posição é ocupada ou liberada e há alguém esperando
+} JobQueue;
+
+int queue_init(JobQueue *queue, size_t capacity);
+void queue_free(JobQueue *queue);
+int queue_try_push(JobQueue *queue, const PuzzleJob *job);
+int queue_try_pop(JobQueue *queue, PuzzleJob *job);
+void queue_push(JobQueue *queue, const PuzzleJob *job);
+void queue_pop(JobQueue *queue, PuzzleJob *job);
+
+#endif
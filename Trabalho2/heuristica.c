@@ -1,194 +1,664 @@
 #include "heuristica.h"
+#include "execucao.h"
+#include "propagacao_lote.h"
+#include "paralelo.h"
+#include "fila.h"
+#include "leitura.h"
+#include "binario.h"
+#include "compressao.h"
+#include "escrita.h"
+#include "servidor.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <time.h>
 #include <sys/time.h>
+#include <pthread.h>
 
-// Função para verificar se o número é válido na célula
-int is_valid(int grid[SIZE][SIZE], int row, int col, int num) {
-    for (int x = 0; x < SIZE; x++) {
-        if (grid[row][x] == num || grid[x][col] == num) return 0;
-    }
-    int start_row = row - row % 3, start_col = col - col % 3;
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (grid[start_row + i][start_col + j] == num) return 0;
+// Função de backtracking usando a heurística MRV, com propagação do nível escolhido
+// Antes da busca, a propagação resolve sozinha os Sudokus que não precisam de tentativas
+int heuristic_solve(int grid[SIZE][SIZE], int level, SolveStats *stats) {
+    Search search;
+    search_init(&search, grid, SELECT_MRV, level);
+    int status = search_run(&search, 0);
+    search_stats(&search, stats);
+    return status == SEARCH_SOLVED;
+}
+
+// Função de backtracking pura, sem propagação
+int backtracking_solve(int grid[SIZE][SIZE]) {
+    Search search;
+    search_init(&search, grid, SELECT_ORDER, PROP_NONE);
+    return search_run(&search, 0) == SEARCH_SOLVED;
+}
+
+// Função de resolução da heurística: MRV e, se ela falhar, backtracking
+// A busca que falhou desfaz todas as suas jogadas, então o backtracking parte da grade original
+static int solve_with_fallback(int grid[SIZE][SIZE], int level, SolveStats *stats, int *fallback) {
+    *fallback = 0;
+    if (heuristic_solve(grid, level, stats)) return 1;
+    *fallback = 1;
+    return backtracking_solve(grid);
+}
+
+// Tentativas feitas por um motor entre duas verificações do vencedor da corrida
+#define RACE_SLICE 256
+
+// Corrida da opção -r: as threads dos motores são criadas uma vez e esperam aqui cada Sudoku
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t start;   // avisada quando começa uma rodada (um Sudoku) ou quando a corrida acaba
+    pthread_cond_t done;    // avisada quando o último motor da rodada para
+    long round;             // número da rodada atual
+    int running;            // motores que ainda não pararam nesta rodada
+    int quit;               // 1 quando não há mais Sudokus
+    int winner;             // índice do primeiro motor a terminar (-1 enquanto a rodada continua)
+} Race;
+
+// Um motor da corrida (opção -r): a configuração da busca e sua cópia particular da grade
+typedef struct {
+    char name[48];
+    int select;
+    int level;
+    int order;
+    unsigned int seed;
+    int grid[SIZE][SIZE];
+    Search search;
+    int id;
+    Race *race;
+    struct timespec cpu_start, cpu_end;
+} Engine;
+
+// Função para configurar os motores: backtracking puro, MRV em ordem crescente, MRV em ordem
+// decrescente e, a partir do quarto, MRV com ordens aleatórias de sementes diferentes
+static void setup_engines(Engine *engines, int count, int level, Race *race) {
+    for (int e = 0; e < count; e++) {
+        Engine *engine = &engines[e];
+        engine->id = e;
+        engine->race = race;
+        engine->select = SELECT_MRV;
+        engine->level = level;
+        engine->seed = 0;
+        if (e == 0) {
+            snprintf(engine->name, sizeof(engine->name), "Backtracking");
+            engine->select = SELECT_ORDER;
+            engine->level = PROP_NONE;
+            engine->order = ORDER_ASCENDING;
+        } else if (e == 1) {
+            snprintf(engine->name, sizeof(engine->name), "MRV");
+            engine->order = ORDER_ASCENDING;
+        } else if (e == 2) {
+            snprintf(engine->name, sizeof(engine->name), "MRV decrescente");
+            engine->order = ORDER_DESCENDING;
+        } else {
+            engine->seed = e - 2;
+            snprintf(engine->name, sizeof(engine->name), "MRV aleatória (semente %u)", engine->seed);
+            engine->order = ORDER_RANDOM;
         }
     }
-    return 1;
 }
 
-// Função para calcular o número de possibilidades para uma célula
-int count_possibilities(int grid[SIZE][SIZE], int row, int col) {
-    int count = 0;
-    for (int num = 1; num <= SIZE; num++) {
-        if (is_valid(grid, row, col, num)) count++;
+// Rodada de um motor: avança a busca em fatias e desiste assim que outro motor terminar
+// Um motor que termina sem solução também vence: todas as buscas são completas, então ele
+// já provou que o Sudoku não tem solução
+static void run_engine(Engine *engine) {
+    int *winner = &engine->race->winner;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &engine->cpu_start);
+
+    int status = search_init(&engine->search, engine->grid, engine->select, engine->level);
+    search_set_order(&engine->search, engine->order, engine->seed);
+    while (status == SEARCH_RUNNING && __atomic_load_n(winner, __ATOMIC_RELAXED) < 0) {
+        status = search_run(&engine->search, RACE_SLICE);
+    }
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &engine->cpu_end);
+    if (status != SEARCH_RUNNING) {
+        int expected = -1;
+        __atomic_compare_exchange_n(winner, &expected, engine->id, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
     }
-    return count;
 }
 
-// Função para encontrar a célula com menos possibilidades (heurística MRV)
-Cell find_best_cell(int grid[SIZE][SIZE]) {
-    Cell best_cell = {-1, -1, SIZE + 1};
-    for (int row = 0; row < SIZE; row++) {
-        for (int col = 0; col < SIZE; col++) {
-            if (grid[row][col] == 0) {
-                int possibilities = count_possibilities(grid, row, col);
-                if (possibilities < best_cell.possibilities) {
-                    best_cell.row = row;
-                    best_cell.col = col;
-                    best_cell.possibilities = possibilities;
-                }
-            }
+// Thread de um motor: espera cada rodada, corre e avisa quando parou, até a corrida acabar
+static void *engine_thread(void *arg) {
+    Engine *engine = arg;
+    Race *race = engine->race;
+    long round = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&race->lock);
+        while (race->round == round && !race->quit) pthread_cond_wait(&race->start, &race->lock);
+        if (race->round == round) { // Sem rodada nova: a corrida acabou
+            pthread_mutex_unlock(&race->lock);
+            return NULL;
         }
+        round = race->round;
+        pthread_mutex_unlock(&race->lock);
+
+        run_engine(engine);
+
+        pthread_mutex_lock(&race->lock);
+        if (--race->running == 0) pthread_cond_signal(&race->done);
+        pthread_mutex_unlock(&race->lock);
     }
-    return best_cell;
 }
 
-// Função de backtracking usando a heurística MRV
-int heuristic_solve(int grid[SIZE][SIZE]) {
-    Cell cell = find_best_cell(grid);
-    if (cell.row == -1) return 1; // Sudoku resolvido
+// Função para resolver o arquivo com uma corrida entre count motores por Sudoku (opção -r)
+// Cada motor roda em sua thread sobre uma cópia da grade; o primeiro a terminar cancela os
+// outros. As threads são criadas uma vez e recebem um Sudoku por rodada, então Sudokus fáceis
+// não pagam a criação de threads. A latência vai do início da rodada até todos os motores pararem
+// Os Sudokus vêm do leitor um por vez e são escritos assim que a corrida termina; os sem
+// solução saem como foram lidos
+static void solve_with_portfolio(const char *input_file, const char *output_file, int level, int count, FILE *csv, int binary_output) {
+    Engine *engines = malloc(count * sizeof(Engine));
+    pthread_t *ids = malloc(count * sizeof(pthread_t));
+    if (!engines || !ids) {
+        perror("Erro ao alocar os motores da corrida");
+        exit(EXIT_FAILURE);
+    }
+    init_tables(); // As tabelas de vizinhos são montadas antes de criar as threads
+
+    Race race = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, -1};
+    setup_engines(engines, count, level, &race);
+    int *wins = calloc(count, sizeof(int));
+    if (!wins) {
+        perror("Erro ao alocar os motores da corrida");
+        exit(EXIT_FAILURE);
+    }
+
+    int started = 0;
+    for (; started < count; started++) {
+        if (pthread_create(&ids[started], NULL, engine_thread, &engines[started]) != 0) break;
+    }
+    if (started == 0) {
+        perror("Erro ao criar as threads da corrida");
+        exit(EXIT_FAILURE);
+    }
+    if (started < count) fprintf(stderr, "Erro ao criar thread; a corrida segue com %d motores.\n", started);
+
+    PuzzleReader reader;
+    reader_open(&reader, input_file);
+    FILE *output = output_open(output_file);
 
-    for (int num = 1; num <= SIZE; num++) {
-        if (is_valid(grid, cell.row, cell.col, num)) {
-            grid[cell.row][cell.col] = num;
-            if (heuristic_solve(grid)) return 1;
-            grid[cell.row][cell.col] = 0;
+    TextWriter text;
+    BinaryWriter binary;
+    if (binary_output) binary_writer_start(&binary, output, 0);
+    else text_writer_start(&text, output);
+
+    int grid[SIZE][SIZE];
+    long p = 0;
+    struct timeval total_start, total_end;
+    gettimeofday(&total_start, NULL);
+
+    for (; reader_next(&reader, grid); p++) {
+        if (reader.truncated) {
+            report_truncated(p);
+            if (binary_output) binary_writer_put(&binary, grid);
+            else text_writer_put(&text, grid);
+            continue;
+        }
+        printf("Resolvendo Sudoku #%ld com %d motores em corrida...\n", p + 1, count);
+
+        struct timeval start, end;
+        gettimeofday(&start, NULL);
+        for (int e = 0; e < started; e++) memcpy(engines[e].grid, grid, sizeof(engines[e].grid));
+
+        pthread_mutex_lock(&race.lock);
+        race.winner = -1;
+        race.running = started;
+        race.round++;
+        pthread_cond_broadcast(&race.start);
+        while (race.running > 0) pthread_cond_wait(&race.done, &race.lock);
+        pthread_mutex_unlock(&race.lock);
+        gettimeofday(&end, NULL);
+
+        int winner = race.winner;
+        Engine *first = &engines[winner];
+        if (first->search.status != SEARCH_SOLVED) {
+            wins[winner]++;
+            fprintf(stderr, "Sem solução para o Sudoku #%ld (provado por %s).\n", p + 1, first->name);
+        } else {
+            wins[winner]++;
+            memcpy(grid, first->grid, sizeof(grid));
+
+            SolveStats stats;
+            search_stats(&first->search, &stats);
+            printf("Vencedor: %s\n", first->name);
+            double cpu_time = measure_cpu_time(&first->cpu_start, &first->cpu_end);
+            double latency = measure_wall_time(&start, &end);
+            printf("Células preenchidas por propagação: %ld, tentativas: %ld\n", stats.filled, stats.nodes);
+            if (csv) {
+                fprintf(csv, "%ld,%s,%d,%.6f,%.6f,%ld,%ld\n", p + 1, first->name, first->level, cpu_time, latency,
+                        stats.filled, stats.nodes);
+            }
         }
+
+        if (binary_output) binary_writer_put(&binary, grid);
+        else text_writer_put(&text, grid);
     }
-    return 0; // Sem solução
+
+    if (binary_output) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+    gettimeofday(&total_end, NULL);
+    reader_close(&reader);
+    output_close(output);
+
+    pthread_mutex_lock(&race.lock);
+    race.quit = 1;
+    pthread_cond_broadcast(&race.start);
+    pthread_mutex_unlock(&race.lock);
+    for (int e = 0; e < started; e++) pthread_join(ids[e], NULL);
+
+    printf("Vitórias por motor:");
+    for (int e = 0; e < started; e++) printf(" %s = %d%s", engines[e].name, wins[e], e < started - 1 ? "," : "\n");
+
+    print_throughput(stdout, p, &total_start, &total_end);
+
+    free(wins);
+    free(ids);
+    free(engines);
 }
 
-// Função de backtracking pura
-int backtracking_solve(int grid[SIZE][SIZE]) {
-    for (int row = 0; row < SIZE; row++) {
-        for (int col = 0; col < SIZE; col++) {
-            if (grid[row][col] == 0) {
-                for (int num = 1; num <= SIZE; num++) {
-                    if (is_valid(grid, row, col, num)) {
-                        grid[row][col] = num;
-                        if (backtracking_solve(grid)) return 1;
-                        grid[row][col] = 0;
-                    }
-                }
-                return 0; // Sem solução
+// Capacidade das filas entre as etapas da esteira
+#define PIPELINE_QUEUE 256
+// Máximo de Sudokus lidos e ainda não escritos; limita a memória do reordenamento
+#define REORDER_WINDOW 1024
+
+// Estado compartilhado pelas etapas da esteira (opção -e)
+typedef struct {
+    PuzzleReader reader;
+    JobQueue to_solve;   // leitor -> resolvedores
+    JobQueue solved;     // resolvedores -> escritor
+    int workers;
+    int level;
+    long written;        // Sudokus já escritos, em ordem
+    pthread_mutex_t window_lock;
+    pthread_cond_t window_moved;   // avisada quando o escritor avança written
+} Pipeline;
+
+// Etapa de leitura: lê um Sudoku por vez e o entrega aos resolvedores
+// No fim manda um marcador para cada resolvedor
+static void *read_stage(void *arg) {
+    Pipeline *pipeline = arg;
+    PuzzleJob job;
+    job.solved = 0;
+
+    for (long index = 0;; index++) {
+        // Não passa mais que REORDER_WINDOW Sudokus à frente do escritor: dorme até ele avançar
+        if (index - __atomic_load_n(&pipeline->written, __ATOMIC_ACQUIRE) >= REORDER_WINDOW) {
+            pthread_mutex_lock(&pipeline->window_lock);
+            while (index - pipeline->written >= REORDER_WINDOW) {
+                pthread_cond_wait(&pipeline->window_moved, &pipeline->window_lock);
             }
+            pthread_mutex_unlock(&pipeline->window_lock);
         }
+        if (!reader_next(&pipeline->reader, job.grid)) break;
+        job.index = index;
+        job.incomplete = pipeline->reader.truncated;
+        queue_push(&pipeline->to_solve, &job);
     }
-    return 1; // Solução encontrada
+
+    job.index = -1;
+    for (int w = 0; w < pipeline->workers; w++) queue_push(&pipeline->to_solve, &job);
+    return NULL;
 }
 
-// Função para carregar múltiplos Sudokus do arquivo
-int load_multiple_sudokus(const char *filename, int puzzles[][SIZE][SIZE]) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        perror("Erro ao abrir arquivo de entrada");
+// Etapa de resolução: heurística e, se ela falhar, backtracking
+// O marcador de fim é repassado ao escritor, que para depois de receber um de cada resolvedor
+static void *solve_stage(void *arg) {
+    Pipeline *pipeline = arg;
+    PuzzleJob job;
+    SolveStats stats;
+
+    for (;;) {
+        queue_pop(&pipeline->to_solve, &job);
+        if (job.index >= 0 && !job.incomplete) {
+            job.solved = heuristic_solve(job.grid, pipeline->level, &stats) || backtracking_solve(job.grid);
+        }
+        queue_push(&pipeline->solved, &job);
+        if (job.index < 0) break;
+    }
+    return NULL;
+}
+
+// Função para resolver o arquivo em uma esteira de três etapas (opção -e)
+// Uma thread lê, workers threads resolvem e a thread atual escreve, devolvendo os resultados à
+// ordem da entrada. Leitura, resolução e escrita se sobrepõem e a memória não cresce com o arquivo
+// Uma etapa sem trabalho (fila vazia ou janela cheia) dorme, sem ocupar um núcleo
+static void solve_pipelined(const char *input_file, const char *output_file, int level, int workers, int binary_output) {
+    Pipeline pipeline = {{0}, {0}, {0}, workers, level, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER};
+    reader_open(&pipeline.reader, input_file);
+    FILE *output = output_open(output_file);
+
+    // Janela de reordenamento: o Sudoku index espera na posição index % REORDER_WINDOW
+    PuzzleJob *window = malloc(REORDER_WINDOW * sizeof(PuzzleJob));
+    char *ready = calloc(REORDER_WINDOW, 1);
+    pthread_t *ids = malloc((workers + 1) * sizeof(pthread_t));
+    if (!window || !ready || !ids || !queue_init(&pipeline.to_solve, PIPELINE_QUEUE) ||
+        !queue_init(&pipeline.solved, PIPELINE_QUEUE)) {
+        perror("Erro ao alocar a esteira");
         exit(EXIT_FAILURE);
     }
-    int puzzle_count = 0;
-    while (!feof(file)) {
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                char ch;
-                fscanf(file, " %c", &ch);
-                puzzles[puzzle_count][i][j] = (ch == EMPTY) ? 0 : ch - '0';
+
+    TextWriter text;
+    BinaryWriter binary;
+    if (binary_output) binary_writer_start(&binary, output, 0);
+    else text_writer_start(&text, output);
+
+    init_tables(); // As tabelas de vizinhos são montadas antes de criar as threads
+    struct timeval start, first_result, end;
+    gettimeofday(&start, NULL);
+
+    int started = 0;
+    if (pthread_create(&ids[started], NULL, read_stage, &pipeline) != 0) {
+        perror("Erro ao criar a thread de leitura");
+        exit(EXIT_FAILURE);
+    }
+    for (started = 1; started <= workers; started++) {
+        if (pthread_create(&ids[started], NULL, solve_stage, &pipeline) != 0) {
+            perror("Erro ao criar a thread de resolução");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Etapa de escrita: termina quando todos os resolvedores tiverem repassado o marcador de fim
+    long next = 0;
+    int unsolved = 0;
+    for (int finished = 0; finished < workers;) {
+        PuzzleJob job;
+        queue_pop(&pipeline.solved, &job);
+        if (job.index < 0) {
+            finished++;
+            continue;
+        }
+
+        window[job.index % REORDER_WINDOW] = job;
+        ready[job.index % REORDER_WINDOW] = 1;
+        long first = next;
+        while (ready[next % REORDER_WINDOW]) {
+            PuzzleJob *result = &window[next % REORDER_WINDOW];
+            if (result->incomplete) {
+                report_truncated(next);
+                unsolved++;
+            } else if (!result->solved) {
+                fprintf(stderr, "Sem solução para o Sudoku #%ld.\n", next + 1);
+                unsolved++;
             }
+            if (next == 0) gettimeofday(&first_result, NULL);
+            if (binary_output) binary_writer_put(&binary, result->grid);
+            else text_writer_put(&text, result->grid);
+            ready[next % REORDER_WINDOW] = 0;
+            next++;
+        }
+        if (next != first) {
+            pthread_mutex_lock(&pipeline.window_lock);
+            __atomic_store_n(&pipeline.written, next, __ATOMIC_RELEASE);
+            pthread_cond_signal(&pipeline.window_moved);
+            pthread_mutex_unlock(&pipeline.window_lock);
         }
-        puzzle_count++;
-        fgetc(file); // Ignora linhas em branco
-        fgetc(file);
     }
-    fclose(file);
-    return puzzle_count;
+    gettimeofday(&end, NULL);
+
+    for (int t = 0; t < started; t++) pthread_join(ids[t], NULL);
+    reader_close(&pipeline.reader);
+    if (binary_output) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+    output_close(output);
+
+    if (next > 0) {
+        double latency = (first_result.tv_sec - start.tv_sec) + (first_result.tv_usec - start.tv_usec) * 1e-6;
+        printf("Primeiro resultado em %.6f segundos\n", latency);
+    }
+    printf("Resolvidos: %ld, sem solução: %d\n", next - unsolved, unsolved);
+    print_throughput(stdout, next, &start, &end);
+
+    queue_free(&pipeline.to_solve);
+    queue_free(&pipeline.solved);
+    free(window);
+    free(ready);
+    free(ids);
 }
 
-// Função para salvar múltiplos Sudokus no arquivo
-void save_multiple_sudokus(const char *filename, int puzzles[][SIZE][SIZE], int puzzle_count) {
-    FILE *file = fopen(filename, "w");
-    if (!file) {
-        perror("Erro ao abrir arquivo de saída");
+// Uma busca intercalada: o estado completo da busca e o Sudoku que ela está resolvendo
+typedef struct {
+    Search search;
+    long puzzle;   // -1 se a posição está livre
+} Slot;
+
+// Sudokus lidos e ainda não escritos no modo intercalado; limita a memória do reordenamento
+#define INTERLEAVE_WINDOW 1024
+
+// Pede ao processador as partes do estado que a próxima tentativa da busca vai ler:
+// a decisão do topo da pilha, os baldes da MRV, as máscaras, o fim do rastro e a grade
+static void prefetch_search(const Search *search) {
+    __builtin_prefetch(&search->stack[search->depth > 0 ? search->depth - 1 : 0]);
+    __builtin_prefetch(search->queue.head);
+    __builtin_prefetch(search->state.rows);
+    __builtin_prefetch(search->state.boxes);
+    __builtin_prefetch(&search->trail.entries[search->trail.len > 0 ? search->trail.len - 1 : 0]);
+    __builtin_prefetch(search->state.grid);
+}
+
+// Função para resolver o arquivo intercalando até ways buscas na mesma thread (opção -i)
+// Cada busca faz uma tentativa por vez (search_run com limite de 1) e cede a vez para a
+// seguinte, cujo estado já foi pedido com prefetch; assim a espera pela memória de uma
+// busca se sobrepõe ao trabalho das outras. Uma posição livre recebe o próximo Sudoku do
+// leitor. As buscas terminam fora de ordem, então cada Sudoku espera na janela de
+// reordenamento (posição índice % INTERLEAVE_WINDOW) até os anteriores serem escritos
+static void solve_interleaved(const char *input_file, const char *output_file, int level, int ways, int binary_output) {
+    Slot *slots = malloc(ways * sizeof(Slot));
+    int (*window)[SIZE][SIZE] = malloc(INTERLEAVE_WINDOW * sizeof(*window));
+    char *done = calloc(INTERLEAVE_WINDOW, 1);
+    if (!slots || !window || !done) {
+        perror("Erro ao alocar as buscas intercaladas");
         exit(EXIT_FAILURE);
     }
-    for (int p = 0; p < puzzle_count; p++) {
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (puzzles[p][i][j] == 0) {
-                    fprintf(file, "%c ", EMPTY);
-                } else {
-                    fprintf(file, "%d ", puzzles[p][i][j]);
+    for (int s = 0; s < ways; s++) slots[s].puzzle = -1;
+
+    PuzzleReader reader;
+    reader_open(&reader, input_file);
+    FILE *output = output_open(output_file);
+
+    TextWriter text;
+    BinaryWriter binary;
+    if (binary_output) binary_writer_start(&binary, output, 0);
+    else text_writer_start(&text, output);
+
+    long next = 0, written = 0;
+    int more = 1, active;
+    int by_search = 0, by_backtracking = 0, unsolved = 0;
+    long nodes = 0;
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+
+    do {
+        active = 0;
+        for (int s = 0; s < ways; s++) {
+            Slot *slot = &slots[s];
+            if (slot->puzzle < 0) {
+                // Não passa mais que INTERLEAVE_WINDOW Sudokus à frente do escritor
+                if (!more || next - written >= INTERLEAVE_WINDOW) continue;
+                if (!reader_next(&reader, window[next % INTERLEAVE_WINDOW])) {
+                    more = 0;
+                    continue;
                 }
+                if (reader.truncated) {
+                    // Acabou no meio da grade: sai como foi lido, sem busca
+                    report_truncated(next);
+                    unsolved++;
+                    done[next++ % INTERLEAVE_WINDOW] = 1;
+                    more = 0;
+                    continue;
+                }
+                slot->puzzle = next++;
+                search_init(&slot->search, window[slot->puzzle % INTERLEAVE_WINDOW], SELECT_MRV, level);
+            } else {
+                const Slot *following = &slots[(s + 1) % ways];
+                if (following->puzzle >= 0) prefetch_search(&following->search);
+                search_run(&slot->search, 1);
             }
-            fprintf(file, "\n");
+            active++;
+
+            if (slot->search.status == SEARCH_RUNNING) continue;
+
+            // Busca terminada: libera a posição para o próximo Sudoku
+            long p = slot->puzzle;
+            nodes += slot->search.nodes;
+            slot->puzzle = -1;
+            if (slot->search.status == SEARCH_SOLVED) {
+                by_search++;
+            } else if (backtracking_solve(window[p % INTERLEAVE_WINDOW])) {
+                by_backtracking++;
+            } else {
+                fprintf(stderr, "Sem solução para o Sudoku #%ld.\n", p + 1);
+                unsolved++;
+            }
+            done[p % INTERLEAVE_WINDOW] = 1;
         }
-        if (p < puzzle_count - 1) {
-            fprintf(file, "\n");
+
+        // Escreve, na ordem da entrada, os Sudokus que já podem sair
+        while (written < next && done[written % INTERLEAVE_WINDOW]) {
+            if (binary_output) binary_writer_put(&binary, window[written % INTERLEAVE_WINDOW]);
+            else text_writer_put(&text, window[written % INTERLEAVE_WINDOW]);
+            done[written % INTERLEAVE_WINDOW] = 0;
+            written++;
         }
-    }
-    fclose(file);
-}
+    } while (active > 0);
 
-// Função para medir o tempo de CPU
-void measure_cpu_time(clock_t start, clock_t end) {
-    double elapsed = ((double)(end - start)) / CLOCKS_PER_SEC;
-    printf("Tempo de execução (CPU): %.6f segundos\n", elapsed);
-}
+    if (binary_output) binary_writer_finish(&binary);
+    else text_writer_finish(&text);
+    gettimeofday(&end, NULL);
 
-// Função para medir o tempo de relógio
-void measure_wall_time(struct timeval *start, struct timeval *end) {
-    long seconds = end->tv_sec - start->tv_sec;
-    long microseconds = end->tv_usec - start->tv_usec;
-    double elapsed = seconds + microseconds * 1e-6;
-    printf("Tempo de execução (relógio): %.6f segundos\n", elapsed);
+    reader_close(&reader);
+    output_close(output);
+    free(slots);
+    free(window);
+    free(done);
+
+    printf("Resolvidos com %d buscas intercaladas: %d, com backtracking: %d, sem solução: %d, tentativas: %ld\n",
+           ways, by_search, by_backtracking, unsolved, nodes);
+    print_throughput(stdout, written, &start, &end);
 }
 
 // Função principal
 int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida>\n", argv[0]);
-        exit(EXIT_FAILURE);
-    }
+    char *csv_file = NULL;
+    int level = PROP_SINGLES;
+    int batch_mode = 0;
+    int ways = 0; // buscas intercaladas (0 = laço sequencial)
+    int threads = 1;
+    int engines = 0; // motores da corrida (0 = sem corrida)
+    int pipeline_workers = 0; // resolvedores da esteira (0 = sem esteira)
+    int streaming = 0;
+    int binary_output = 0;
+    char *socket_path = NULL; // modo servidor (-d)
+    int opt;
 
-    char *input_file = argv[1];
-    char *output_file = argv[2];
+    while ((opt = getopt(argc, argv, "t:p:li:j:r:e:sbd:")) != -1) {
+        switch (opt) {
+            case 't':
+                csv_file = optarg;
+                break;
+            case 'l':
+                batch_mode = 1;
+                break;
+            case 'i':
+                ways = atoi(optarg);
+                break;
+            case 'j':
+                threads = atoi(optarg);
+                break;
+            case 'r':
+                engines = atoi(optarg);
+                break;
+            case 'e':
+                pipeline_workers = atoi(optarg);
+                break;
+            case 's':
+                streaming = 1;
+                break;
+            case 'b':
+                binary_output = 1;
+                break;
+            case 'd':
+                socket_path = optarg;
+                break;
+            case 'p':
+                level = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-t <arquivo_csv>] [-p <nivel 0-%d>] [-l | -i <buscas> | -j <threads> | -r <motores> | -e <resolvedores> | -s] [-b] <arquivo_entrada> <arquivo_saida>\n"
+                                "     %s [-p <nivel 0-%d>] [-j <threads>] -d <socket | ->\n", argv[0], PROP_MAX, argv[0], PROP_MAX);
+                exit(EXIT_FAILURE);
+        }
+    }
 
-    int puzzles[100][SIZE][SIZE];
-    clock_t cpu_start, cpu_end;
-    struct timeval wall_start, wall_end;
+    // No modo servidor não há arquivos, e -j dá o número de threads de atendimento
+    int daemon_mode = socket_path != NULL;
+    if (argc - optind != (daemon_mode ? 0 : 2) || level < PROP_NONE || level > PROP_MAX || ways < 0 ||
+        threads < 1 || threads > MAX_THREADS || engines < 0 || engines > MAX_THREADS ||
+        pipeline_workers < 0 || pipeline_workers > MAX_THREADS ||
+        ((batch_mode || ways > 0 || pipeline_workers > 0 || streaming || daemon_mode) && csv_file) ||
+        (daemon_mode && binary_output) ||
+        batch_mode + (ways > 0) + (threads > 1 && !daemon_mode) + (engines > 0) + (pipeline_workers > 0) + streaming + daemon_mode > 1) {
+        fprintf(stderr, "Uso: %s [-t <arquivo_csv>] [-p <nivel 0-%d>] [-l | -i <buscas> | -j <threads> | -r <motores> | -e <resolvedores> | -s] [-b] <arquivo_entrada> <arquivo_saida>\n"
+                        "     %s [-p <nivel 0-%d>] [-j <threads>] -d <socket | ->\n", argv[0], PROP_MAX, argv[0], PROP_MAX);
+        exit(EXIT_FAILURE);
+    }
 
-    // Carrega múltiplos Sudokus
-    int puzzle_count = load_multiple_sudokus(input_file, puzzles);
+    if (daemon_mode) {
+        serve(socket_path, level, threads);
+        return 0;
+    }
 
-    for (int p = 0; p < puzzle_count; p++) {
-        printf("Resolvendo Sudoku #%d com heurística...\n", p + 1);
+    char *input_file = argv[optind];
+    char *output_file = argv[optind + 1];
 
-        // Tentar resolver com heurística
-        gettimeofday(&wall_start, NULL);
-        cpu_start = clock();
-        int solved = heuristic_solve(puzzles[p]);
-        cpu_end = clock();
-        gettimeofday(&wall_end, NULL);
+    // Todos os modos leem e escrevem o arquivo aos poucos, sem carregar todos os Sudokus
+    if (streaming) {
+        solve_streaming(input_file, output_file, solve_with_fallback, level, binary_output);
+        return 0;
+    }
+    if (batch_mode) {
+        printf("Resolvendo em lotes de %d...\n", BATCH_LANES);
+        solve_in_batches(input_file, output_file, solve_with_fallback, level, binary_output);
+        printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
+        return 0;
+    }
+    if (pipeline_workers > 0) {
+        printf("Resolvendo em esteira com %d resolvedores...\n", pipeline_workers);
+        solve_pipelined(input_file, output_file, level, pipeline_workers, binary_output);
+        printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
+        return 0;
+    }
 
-        if (!solved) {
-            printf("Heurística falhou para Sudoku #%d, tentando backtracking...\n", p + 1);
-            gettimeofday(&wall_start, NULL);
-            cpu_start = clock();
-            solved = backtracking_solve(puzzles[p]);
-            cpu_end = clock();
-            gettimeofday(&wall_end, NULL);
-        }
+    // No modo intercalado não há tempos por Sudoku, só o total (por isso -t não vale com -i)
+    if (ways > 0) {
+        printf("Resolvendo com %d buscas intercaladas...\n", ways);
+        solve_interleaved(input_file, output_file, level, ways, binary_output);
+        printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
+        return 0;
+    }
 
-        if (!solved) {
-            fprintf(stderr, "Sem solução para o Sudoku #%d.\n", p + 1);
-        } else {
-            measure_cpu_time(cpu_start, cpu_end);
-            measure_wall_time(&wall_start, &wall_end);
+    // Tempos de cada Sudoku, no mesmo formato do tempos.csv
+    FILE *csv = NULL;
+    if (csv_file) {
+        csv = fopen(csv_file, "w");
+        if (!csv) {
+            perror("Erro ao criar arquivo de tempos");
+            exit(EXIT_FAILURE);
         }
+        fprintf(csv, "Sudoku,Metodo,Nivel,Tempo CPU,Tempo Relogio,Celulas Propagadas,Nos\n");
     }
 
-    save_multiple_sudokus(output_file, puzzles, puzzle_count);
+    // Corrida (-r), modo padrão e -j: tempos de cada Sudoku
+    // (-b salva no formato binário; a entrada é reconhecida sozinha pelo leitor)
+    if (engines > 0) {
+        solve_with_portfolio(input_file, output_file, level, engines, csv, binary_output);
+    } else {
+        solve_file(input_file, output_file, solve_with_fallback, level, threads, csv, binary_output);
+    }
+    if (csv) fclose(csv);
 
     printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
 
@@ -0,0 +1,287 @@
+#include "leitura.h"
+#include "compressao.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Espaço em branco, como no fscanf(" "): ' ', '\t', '\n', '\v', '\f' e '\r' (o '\r' cobre o CRLF)
+static inline int is_blank(unsigned char ch) {
+    return ch == ' ' || (unsigned char)(ch - '\t') <= '\r' - '\t';
+}
+
+// Valor da célula: 'v' é vazia; os dígitos valem ch - '0' (outros símbolos ficam fora de 1..9
+// e são recusados pelo resolvedor)
+static inline int decode_cell(unsigned char ch) {
+    return ch == EMPTY ? 0 : ch - '0';
+}
+
+// Função para conferir o cabeçalho de uma entrada binária; retorna 0 se ela não servir
+static int open_binary(PuzzleReader *reader, const unsigned char *bytes, size_t size) {
+    if (!binary_parse_header(bytes, size, &reader->header)) {
+        fprintf(stderr, "Arquivo binário inválido ou de versão não suportada.\n");
+        return 0;
+    }
+    if (reader->header.size != SIZE) {
+        fprintf(stderr, "Arquivo binário com Sudokus %dx%d; este programa só resolve %dx%d.\n",
+                reader->header.size, reader->header.size, SIZE, SIZE);
+        return 0;
+    }
+    reader->binary = 1;
+    reader->record_size = binary_record_size(&reader->header);
+    reader->remaining = reader->header.count;
+    return 1;
+}
+
+// Função para detectar o formato no modo stdio, olhando o primeiro byte
+// Uma entrada comprimida passa a ser lida pelo descompressor e o formato é conferido de novo
+// nos dados descomprimidos; nenhuma célula do formato de texto começa com 'S' (binário)
+static int detect_file_format(PuzzleReader *reader) {
+    int ch = getc(reader->file);
+    int format = compress_detect(ch);
+    if (format != COMPRESS_NONE) {
+        ungetc(ch, reader->file);
+        reader->file = compress_reader(reader->file, format);
+        ch = getc(reader->file);
+    }
+    if (ch != BINARY_MAGIC[0]) {
+        if (ch != EOF) ungetc(ch, reader->file);
+        return 1;
+    }
+    unsigned char header[BINARY_HEADER_SIZE];
+    header[0] = (unsigned char)ch;
+    size_t n = fread(header + 1, 1, BINARY_HEADER_SIZE - 1, reader->file);
+    return open_binary(reader, header, n + 1);
+}
+
+// Função para abrir o arquivo de entrada; "-" é a entrada padrão
+// Arquivos comuns são mapeados; se não der para mapear, ou se o arquivo estiver comprimido,
+// o leitor usa o stdio. O formato (texto ou binário, gzip ou zstd) é reconhecido pelos primeiros bytes
+void reader_open(PuzzleReader *reader, const char *filename) {
+    reader->data = NULL;
+    reader->size = reader->pos = 0;
+    reader->file = NULL;
+    reader->binary = 0;
+    reader->truncated = 0;
+
+    if (strcmp(filename, "-") == 0) {
+        reader->file = stdin;
+        if (!detect_file_format(reader)) exit(EXIT_FAILURE);
+        return;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Erro ao abrir arquivo de entrada");
+        exit(EXIT_FAILURE);
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        if (info.st_size == 0) {
+            reader->data = (const unsigned char *)""; // Arquivo vazio: nada a mapear
+            close(fd);
+            return;
+        }
+        void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED && compress_detect(*(unsigned char *)map) != COMPRESS_NONE) {
+            munmap(map, info.st_size); // Comprimido: o descompressor lê pelo stdio
+            map = MAP_FAILED;
+        }
+        if (map != MAP_FAILED) {
+            posix_madvise(map, info.st_size, POSIX_MADV_SEQUENTIAL);
+            reader->data = map;
+            reader->size = info.st_size;
+            close(fd); // O mapeamento continua válido depois do close
+            if (reader->size >= 4 && memcmp(reader->data, BINARY_MAGIC, 4) == 0) {
+                if (!open_binary(reader, reader->data, reader->size)) exit(EXIT_FAILURE);
+                reader->pos = BINARY_HEADER_SIZE;
+            }
+            return;
+        }
+    }
+
+    reader->file = fdopen(fd, "r");
+    if (!reader->file) {
+        perror("Erro ao abrir arquivo de entrada");
+        exit(EXIT_FAILURE);
+    }
+    if (!detect_file_format(reader)) exit(EXIT_FAILURE);
+}
+
+// Função para ler Sudokus de um arquivo já aberto (um socket, por exemplo), pelo stdio
+// Retorna 0 se o cabeçalho binário não servir, sem encerrar o programa
+int reader_open_file(PuzzleReader *reader, FILE *file) {
+    reader->data = NULL;
+    reader->size = reader->pos = 0;
+    reader->file = file;
+    reader->binary = 0;
+    reader->truncated = 0;
+    return detect_file_format(reader);
+}
+
+// Lê do arquivo mapeado até completar count células; retorna quantas foram lidas
+static int scan_mapped(PuzzleReader *reader, int *cells, int count) {
+    const unsigned char *data = reader->data;
+    size_t pos = reader->pos, size = reader->size;
+    int n = 0;
+
+#if defined(__SSE2__)
+    // 16 bytes por vez: a máscara marca os bytes que não são espaço em branco (as células)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i range = _mm_set1_epi8('\r' - '\t');
+    while (n < count && pos + 16 <= size) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(data + pos));
+        __m128i offset = _mm_sub_epi8(chunk, tab);
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(offset, range), offset); // '\t'..'\r'
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, space), control);
+        unsigned int mask = ~(unsigned int)_mm_movemask_epi8(blank) & 0xFFFF;
+
+        while (mask) {
+            int i = __builtin_ctz(mask);
+            mask &= mask - 1;
+            cells[n++] = decode_cell(data[pos + i]);
+            if (n == count) {
+                reader->pos = pos + i + 1;
+                return n;
+            }
+        }
+        pos += 16;
+    }
+#endif
+
+    while (n < count && pos < size) {
+        unsigned char ch = data[pos++];
+        if (!is_blank(ch)) cells[n++] = decode_cell(ch);
+    }
+    reader->pos = pos;
+    return n;
+}
+
+// Lê do stdio até completar count células; retorna quantas foram lidas
+static int scan_file(PuzzleReader *reader, int *cells, int count) {
+    int n = 0, ch;
+    while (n < count && (ch = getc(reader->file)) != EOF) {
+        if (!is_blank((unsigned char)ch)) cells[n++] = decode_cell((unsigned char)ch);
+    }
+    return n;
+}
+
+// Lê o próximo registro do formato binário; retorna 0 no fim dos Sudokus
+// Um registro incompleto no fim do arquivo vem com as células que faltam vazias e marca
+// reader->truncated, como um Sudoku incompleto no formato de texto
+static int next_binary(PuzzleReader *reader, int grid[SIZE][SIZE]) {
+    if (reader->remaining == 0) return 0;
+
+    unsigned char buffer[CELLS];
+    const unsigned char *record = buffer;
+    size_t n;
+    if (reader->file) {
+        n = fread(buffer, 1, reader->record_size, reader->file);
+    } else {
+        n = reader->size - reader->pos < reader->record_size ? reader->size - reader->pos : reader->record_size;
+        record = reader->data + reader->pos;
+        reader->pos += n;
+    }
+    if (n < reader->record_size) {
+        if (reader->remaining != BINARY_COUNT_UNKNOWN && reader->remaining > (n > 0)) {
+            fprintf(stderr, "Arquivo binário truncado; os Sudokus que faltam foram ignorados.\n");
+        }
+        reader->remaining = 0;
+        if (n == 0) return 0;
+
+        if (record != buffer) memcpy(buffer, record, n);
+        memset(buffer + n, 0, reader->record_size - n); // Zero é célula vazia com 4 ou 8 bits
+        record = buffer;
+        reader->truncated = 1;
+    } else if (reader->remaining != BINARY_COUNT_UNKNOWN) {
+        reader->remaining--;
+    }
+    binary_decode(&reader->header, record, grid);
+    return 1;
+}
+
+// Função para ler o próximo Sudoku
+// Retorna 0 se só restarem espaços e linhas em branco (não cria um Sudoku fantasma no fim);
+// um Sudoku incompleto no fim do arquivo tem as células que faltam deixadas vazias e marca
+// reader->truncated. O leitor não avisa nada: cada programa diz o que fez com ele
+int reader_next(PuzzleReader *reader, int grid[SIZE][SIZE]) {
+    if (reader->binary) return next_binary(reader, grid);
+
+    int *cells = &grid[0][0];
+    int n = reader->file ? scan_file(reader, cells, CELLS) : scan_mapped(reader, cells, CELLS);
+    if (n == 0) return 0;
+    if (n < CELLS) {
+        reader->truncated = 1;
+        memset(cells + n, 0, (CELLS - n) * sizeof(int));
+    }
+    return 1;
+}
+
+// Função para saber se ainda há alguma célula a ler
+int reader_has_more(PuzzleReader *reader) {
+    if (reader->binary && !reader->file) {
+        return reader->remaining > 0 && reader->size - reader->pos >= reader->record_size;
+    }
+    if (reader->binary) {
+        if (reader->remaining == 0) return 0;
+        int ch = getc(reader->file); // No binário todo byte conta: não pula espaços
+        if (ch == EOF) return 0;
+        ungetc(ch, reader->file);
+        return 1;
+    }
+    if (!reader->file) {
+        while (reader->pos < reader->size && is_blank(reader->data[reader->pos])) reader->pos++;
+        return reader->pos < reader->size;
+    }
+    int ch = getc(reader->file);
+    while (ch != EOF && is_blank((unsigned char)ch)) ch = getc(reader->file);
+    if (ch == EOF) return 0;
+    ungetc(ch, reader->file);
+    return 1;
+}
+
+// Função para ir direto ao Sudoku index (contando do 0); retorna 0 se ele não existir
+// No formato binário mapeado o salto é direto, pelo índice do arquivo quando houver; nos
+// outros casos os Sudokus anteriores são lidos e descartados
+int reader_seek(PuzzleReader *reader, uint64_t index) {
+    if (reader->binary && !reader->file) {
+        uint64_t count = reader->header.count;
+        if (count != BINARY_COUNT_UNKNOWN && index >= count) return 0;
+
+        uint64_t offset = BINARY_HEADER_SIZE + index * reader->record_size;
+        if (reader->header.flags & BINARY_FLAG_INDEX) {
+            uint64_t entry = BINARY_HEADER_SIZE + count * reader->record_size + index * 8;
+            if (entry + 8 > reader->size) return 0;
+            offset = 0;
+            for (int i = 0; i < 8; i++) offset |= (uint64_t)reader->data[entry + i] << (8 * i);
+        }
+        if (offset > reader->size || reader->size - offset < reader->record_size) return 0;
+        reader->pos = offset;
+        reader->remaining = count == BINARY_COUNT_UNKNOWN ? count : count - index;
+        return 1;
+    }
+
+    int skipped[SIZE][SIZE];
+    for (uint64_t i = 0; i < index; i++) {
+        if (!reader_next(reader, skipped)) return 0;
+    }
+    return reader_has_more(reader);
+}
+
+// Função para fechar o arquivo (a entrada padrão fica aberta)
+void reader_close(PuzzleReader *reader) {
+    if (reader->file) {
+        if (reader->file != stdin) fclose(reader->file);
+    } else if (reader->size > 0) {
+        munmap((void *)reader->data, reader->size);
+    }
+    reader->data = NULL;
+    reader->file = NULL;
+}
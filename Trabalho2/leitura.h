@@ -0,0 +1,35 @@
+#ifndef LEITURA_H
+#define LEITURA_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "estado.h"
+#include "binario.h"
+
+// Leitor de Sudokus no formato de texto ('v' ou dígito por célula, separados por espaços e
+// linhas em branco). Cada caractere que não é espaço em branco é uma célula, então o leitor
+// só precisa achar esses caracteres. Arquivos comuns são mapeados na memória e lidos direto
+// das páginas; a entrada padrão, os pipes e os arquivos comprimidos (compressao.h) são lidos
+// pelo stdio.
+// Arquivos que começam com "SDKB" estão no formato binário (binario.h) e são decodificados
+// registro a registro, sem análise de texto.
+typedef struct {
+    const unsigned char *data;   // arquivo mapeado (NULL no modo stdio)
+    size_t size;
+    size_t pos;
+    FILE *file;                  // modo stdio
+    int binary;                  // 1 se a entrada está no formato binário
+    BinaryHeader header;
+    size_t record_size;          // bytes por Sudoku no formato binário
+    uint64_t remaining;          // Sudokus binários ainda não lidos
+    int truncated;               // 1 se o último Sudoku lido acabou antes de completar a grade
+} PuzzleReader;
+
+void reader_open(PuzzleReader *reader, const char *filename);
+int reader_open_file(PuzzleReader *reader, FILE *file);
+int reader_next(PuzzleReader *reader, int grid[SIZE][SIZE]);
+int reader_has_more(PuzzleReader *reader);
+int reader_seek(PuzzleReader *reader, uint64_t index);
+void reader_close(PuzzleReader *reader);
+
+#endif
@@ -0,0 +1,93 @@
+#include "mrv.h"
+
+// Insere a célula no início do balde correspondente à sua contagem
+static void bucket_insert(MrvQueue *queue, int pos, int count) {
+    queue->count[pos] = count;
+    queue->prev[pos] = NO_CELL;
+    queue->next[pos] = queue->head[count];
+    if (queue->head[count] != NO_CELL) queue->prev[queue->head[count]] = pos;
+    queue->head[count] = pos;
+}
+
+// Retira a célula do balde em que ela está
+static void bucket_remove(MrvQueue *queue, int pos) {
+    int prev = queue->prev[pos], next = queue->next[pos];
+    if (prev != NO_CELL) queue->next[prev] = next;
+    else queue->head[queue->count[pos]] = next;
+    if (next != NO_CELL) queue->prev[next] = prev;
+}
+
+// Recalcula a contagem de uma célula vazia e troca de balde se ela mudou
+// Retorna a nova contagem
+static int refresh_cell(MrvQueue *queue, int pos) {
+    int count = count_bits(state_candidates(queue->state, pos / SIZE, pos % SIZE));
+    if (count != queue->count[pos]) {
+        bucket_remove(queue, pos);
+        bucket_insert(queue, pos, count);
+    }
+    return count;
+}
+
+// Função para montar os baldes a partir do estado atual
+void mrv_init(MrvQueue *queue, SudokuState *state) {
+    init_tables();
+    queue->state = state;
+    queue->empty_cells = 0;
+    for (int i = 0; i <= SIZE; i++) queue->head[i] = NO_CELL;
+
+    // Percorre de trás para frente para que cada balde fique em ordem de linha e coluna
+    for (int pos = CELLS - 1; pos >= 0; pos--) {
+        if (state->grid[pos / SIZE][pos % SIZE] != 0) continue;
+        bucket_insert(queue, pos, count_bits(state_candidates(state, pos / SIZE, pos % SIZE)));
+        queue->empty_cells++;
+    }
+}
+
+// Função para obter a célula com menos candidatos, em O(SIZE)
+// Retorna NO_CELL se não houver células vazias
+int mrv_best_cell(const MrvQueue *queue) {
+    for (int count = 0; count <= SIZE; count++) {
+        if (queue->head[count] != NO_CELL) return queue->head[count];
+    }
+    return NO_CELL;
+}
+
+// Função para colocar um dígito e atualizar apenas os vizinhos da célula
+// Retorna 0 se algum vizinho ficou sem candidatos (os baldes continuam consistentes para o mrv_undo)
+int mrv_place(MrvQueue *queue, int pos, int num) {
+    bucket_remove(queue, pos);
+    queue->empty_cells--;
+    state_place(queue->state, pos / SIZE, pos % SIZE, num);
+
+    int ok = 1;
+    for (int i = 0; i < NUM_PEERS; i++) {
+        int peer = peers[pos][i];
+        if (queue->state->grid[peer / SIZE][peer % SIZE] != 0) continue;
+        if (refresh_cell(queue, peer) == 0) ok = 0;
+    }
+    return ok;
+}
+
+// Função para desfazer a jogada da célula e devolvê-la aos baldes
+void mrv_undo(MrvQueue *queue, int pos) {
+    state_undo(queue->state, pos / SIZE, pos % SIZE);
+    for (int i = 0; i < NUM_PEERS; i++) {
+        int peer = peers[pos][i];
+        if (queue->state->grid[peer / SIZE][peer % SIZE] == 0) refresh_cell(queue, peer);
+    }
+    bucket_insert(queue, pos, count_bits(state_candidates(queue->state, pos / SIZE, pos % SIZE)));
+    queue->empty_cells++;
+}
+
+// Função para eliminar candidatos de uma célula vazia
+// Retorna quantos candidatos restaram
+int mrv_eliminate(MrvQueue *queue, int pos, Mask mask) {
+    queue->state->removed[pos] |= mask;
+    return refresh_cell(queue, pos);
+}
+
+// Função para devolver candidatos eliminados por mrv_eliminate
+void mrv_restore(MrvQueue *queue, int pos, Mask mask) {
+    queue->state->removed[pos] &= ~mask;
+    refresh_cell(queue, pos);
+}
\ No newline at end of file
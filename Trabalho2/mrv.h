@@ -0,0 +1,25 @@
+#ifndef MRV_H
+#define MRV_H
+
+#include "estado.h"
+
+#define NO_CELL -1
+
+// Fila de prioridade MRV: as células vazias ficam em baldes indexados pelo número de candidatos
+typedef struct {
+    SudokuState *state;
+    int count[CELLS];     // candidatos de cada célula vazia
+    int next[CELLS];      // próxima célula no mesmo balde
+    int prev[CELLS];      // célula anterior no mesmo balde
+    int head[SIZE + 1];   // primeira célula de cada balde
+    int empty_cells;
+} MrvQueue;
+
+void mrv_init(MrvQueue *queue, SudokuState *state);
+int mrv_best_cell(const MrvQueue *queue);
+int mrv_place(MrvQueue *queue, int pos, int num);
+void mrv_undo(MrvQueue *queue, int pos);
+int mrv_eliminate(MrvQueue *queue, int pos, Mask mask);
+void mrv_restore(MrvQueue *queue, int pos, Mask mask);
+
+#endif
\ No newline at end of file
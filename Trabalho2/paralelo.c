@@ -0,0 +1,54 @@
+#include "paralelo.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Estado compartilhado pelas threads de um parallel_for
+typedef struct {
+    TaskFunction task;
+    void *context;
+    int count;
+    int chunk;
+    int next;   // próximo índice ainda não distribuído (avançado de forma atômica)
+} ParallelLoop;
+
+// Cada thread pega blocos de chunk índices até acabar o laço; quem termina antes pega mais,
+// então um Sudoku difícil não deixa as outras threads paradas
+static void *worker(void *arg) {
+    ParallelLoop *loop = arg;
+    for (;;) {
+        int first = __atomic_fetch_add(&loop->next, loop->chunk, __ATOMIC_RELAXED);
+        if (first >= loop->count) break;
+        int last = first + loop->chunk < loop->count ? first + loop->chunk : loop->count;
+        for (int i = first; i < last; i++) loop->task(i, loop->context);
+    }
+    return NULL;
+}
+
+// Função para executar task(i, context) para i em 0..count-1 usando até threads threads
+// Os índices são distribuídos dinamicamente em blocos pequenos (cerca de 8 por thread);
+// com uma thread o laço roda na thread atual, em ordem
+void parallel_for(int count, int threads, TaskFunction task, void *context) {
+    if (threads > count) threads = count;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    ParallelLoop loop = {task, context, count, 1, 0};
+    if (threads <= 1) {
+        worker(&loop);
+        return;
+    }
+    loop.chunk = count / (threads * 8);
+    if (loop.chunk < 1) loop.chunk = 1;
+
+    // A thread atual também trabalha, então só threads - 1 são criadas
+    pthread_t ids[MAX_THREADS];
+    int created = 0;
+    for (; created < threads - 1; created++) {
+        if (pthread_create(&ids[created], NULL, worker, &loop) != 0) {
+            fprintf(stderr, "Erro ao criar thread; continuando com %d.\n", created + 1);
+            break;
+        }
+    }
+    worker(&loop);
+    for (int t = 0; t < created; t++) pthread_join(ids[t], NULL);
+}
@@ -0,0 +1,12 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+// Tarefa de um laço paralelo: recebe o índice do item e o contexto compartilhado
+typedef void (*TaskFunction)(int index, void *context);
+
+// Maior número de threads aceito pela opção -j
+#define MAX_THREADS 256
+
+void parallel_for(int count, int threads, TaskFunction task, void *context);
+
+#endif
@@ -0,0 +1,248 @@
+#include "propagacao.h"
+
+// As regras abaixo retornam -1 em contradição, 1 se mudaram o estado e 0 caso contrário
+
+// Função para colocar um dígito registrando a célula no rastro, para que unpropagate possa desfazê-la
+int trail_place(MrvQueue *queue, Trail *trail, int pos, int num) {
+    trail->entries[trail->len].pos = pos;
+    trail->entries[trail->len].removed = 0;
+    trail->len++;
+    return mrv_place(queue, pos, num);
+}
+
+// Preenchimento feito pela propagação (contado nas estatísticas)
+static int assign(MrvQueue *queue, Trail *trail, int pos, int num) {
+    trail->filled++;
+    return trail_place(queue, trail, pos, num);
+}
+
+// Elimina candidatos de uma célula vazia e registra a eliminação no rastro
+static int eliminate(MrvQueue *queue, Trail *trail, int pos, Mask mask) {
+    mask &= state_candidates(queue->state, pos / SIZE, pos % SIZE);
+    if (!mask) return 0;
+    trail->entries[trail->len].pos = pos;
+    trail->entries[trail->len].removed = mask;
+    trail->len++;
+    return mrv_eliminate(queue, pos, mask) == 0 ? -1 : 1;
+}
+
+static int is_empty(const MrvQueue *queue, int pos) {
+    return queue->state->grid[pos / SIZE][pos % SIZE] == 0;
+}
+
+// Procura, em cada unidade, dígitos que só cabem em uma célula (únicos escondidos)
+static int hidden_singles(MrvQueue *queue, Trail *trail) {
+    SudokuState *state = queue->state;
+    int changed = 0;
+
+    for (int u = 0; u < NUM_UNITS; u++) {
+        Mask once = 0, twice = 0, placed = 0;
+        for (int i = 0; i < SIZE; i++) {
+            int pos = units[u][i];
+            int value = state->grid[pos / SIZE][pos % SIZE];
+            if (value != 0) {
+                placed |= DIGIT_BIT(value);
+                continue;
+            }
+            Mask candidates = state_candidates(state, pos / SIZE, pos % SIZE);
+            twice |= once & candidates;
+            once |= candidates;
+        }
+        if ((placed | once) != ALL_DIGITS) return -1; // Algum dígito não cabe mais na unidade
+
+        Mask hidden = once & ~twice;
+        while (hidden) {
+            int num = lowest_digit(hidden);
+            hidden &= hidden - 1;
+            for (int i = 0; i < SIZE; i++) {
+                int pos = units[u][i];
+                if (!is_empty(queue, pos)) continue;
+                if (!(state_candidates(state, pos / SIZE, pos % SIZE) & DIGIT_BIT(num))) continue;
+                if (!assign(queue, trail, pos, num)) return -1;
+                changed = 1;
+                break;
+            }
+        }
+    }
+    return changed;
+}
+
+// Pares apontadores (dígito de um bloco preso a uma linha ou coluna) e
+// redução bloco-linha (dígito de uma linha ou coluna preso a um bloco)
+static int intersections(MrvQueue *queue, Trail *trail) {
+    SudokuState *state = queue->state;
+    int changed = 0;
+
+    for (int u = 0; u < NUM_UNITS; u++) {
+        int is_box = u >= 2 * SIZE;
+        for (int num = 1; num <= SIZE; num++) {
+            Mask bit = DIGIT_BIT(num);
+            int count = 0, row = -1, col = -1, box = -1;
+            for (int i = 0; i < SIZE; i++) {
+                int pos = units[u][i];
+                if (!is_empty(queue, pos) || !(state_candidates(state, pos / SIZE, pos % SIZE) & bit)) continue;
+                int r = pos / SIZE, c = pos % SIZE, b = BOX_INDEX(r, c);
+                if (count == 0) {
+                    row = r;
+                    col = c;
+                    box = b;
+                } else {
+                    if (r != row) row = -1;
+                    if (c != col) col = -1;
+                    if (b != box) box = -1;
+                }
+                count++;
+            }
+            if (count < 2) continue; // Zero ou um lugar: tratado pelos únicos escondidos
+
+            if (is_box) {
+                // O dígito do bloco está todo em uma linha ou coluna: sai do resto dela
+                for (int k = 0; k < SIZE; k++) {
+                    int targets[2] = {row >= 0 ? row * SIZE + k : -1, col >= 0 ? k * SIZE + col : -1};
+                    for (int t = 0; t < 2; t++) {
+                        int pos = targets[t];
+                        if (pos < 0 || BOX_INDEX(pos / SIZE, pos % SIZE) == u - 2 * SIZE || !is_empty(queue, pos)) continue;
+                        int result = eliminate(queue, trail, pos, bit);
+                        if (result < 0) return -1;
+                        changed |= result;
+                    }
+                }
+            } else if (box >= 0) {
+                // O dígito da linha ou coluna está todo em um bloco: sai do resto do bloco
+                for (int i = 0; i < SIZE; i++) {
+                    int pos = units[2 * SIZE + box][i];
+                    int inside = (u < SIZE) ? pos / SIZE == u : pos % SIZE == u - SIZE;
+                    if (inside || !is_empty(queue, pos)) continue;
+                    int result = eliminate(queue, trail, pos, bit);
+                    if (result < 0) return -1;
+                    changed |= result;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// Conjuntos nus: k células de uma unidade cujos candidatos somam k dígitos
+// Esses dígitos saem das demais células da unidade
+static int naked_subsets(MrvQueue *queue, Trail *trail, int k) {
+    int changed = 0;
+
+    for (int u = 0; u < NUM_UNITS; u++) {
+        int cells[SIZE], n = 0;
+        Mask candidates[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            int pos = units[u][i];
+            if (!is_empty(queue, pos)) continue;
+            cells[n] = pos;
+            candidates[n] = state_candidates(queue->state, pos / SIZE, pos % SIZE);
+            n++;
+        }
+        if (n <= k) continue;
+
+        for (int a = 0; a < n; a++) {
+            if (count_bits(candidates[a]) > k) continue;
+            for (int b = a + 1; b < n; b++) {
+                Mask pair = candidates[a] | candidates[b];
+                if (count_bits(pair) > k) continue;
+                // Com k == 2 o laço roda uma única vez, com c == n (sem terceira célula)
+                int last = (k == 2) ? n : n - 1;
+                for (int c = (k == 2) ? n : b + 1; c <= last; c++) {
+                    Mask subset = (c < n) ? pair | candidates[c] : pair;
+                    if (count_bits(subset) != k) continue;
+                    for (int j = 0; j < n; j++) {
+                        if (j == a || j == b || j == c) continue;
+                        int result = eliminate(queue, trail, cells[j], subset);
+                        if (result < 0) return -1;
+                        changed |= result;
+                    }
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// Conjuntos escondidos: k dígitos de uma unidade que só cabem nas mesmas k células
+// Essas células perdem todos os outros candidatos
+static int hidden_subsets(MrvQueue *queue, Trail *trail, int k) {
+    int changed = 0;
+
+    for (int u = 0; u < NUM_UNITS; u++) {
+        Mask where[SIZE + 1]; // posições (índices na unidade) onde cada dígito ainda cabe
+        for (int num = 1; num <= SIZE; num++) where[num] = 0;
+        for (int i = 0; i < SIZE; i++) {
+            int pos = units[u][i];
+            if (!is_empty(queue, pos)) continue;
+            Mask candidates = state_candidates(queue->state, pos / SIZE, pos % SIZE);
+            while (candidates) {
+                where[lowest_digit(candidates)] |= (Mask)1u << i;
+                candidates &= candidates - 1;
+            }
+        }
+
+        for (int a = 1; a <= SIZE; a++) {
+            if (count_bits(where[a]) < 2 || count_bits(where[a]) > k) continue;
+            for (int b = a + 1; b <= SIZE; b++) {
+                if (count_bits(where[b]) < 2) continue;
+                Mask pair = where[a] | where[b];
+                if (count_bits(pair) > k) continue;
+                // Com k == 2 o laço roda uma única vez, com c == SIZE + 1 (sem terceiro dígito)
+                int last = (k == 2) ? SIZE + 1 : SIZE;
+                for (int c = (k == 2) ? SIZE + 1 : b + 1; c <= last; c++) {
+                    if (c <= SIZE && count_bits(where[c]) < 2) continue;
+                    Mask positions = (c <= SIZE) ? pair | where[c] : pair;
+                    if (count_bits(positions) != k) continue;
+                    Mask digits = DIGIT_BIT(a) | DIGIT_BIT(b) | ((c <= SIZE) ? DIGIT_BIT(c) : 0);
+                    while (positions) {
+                        int i = __builtin_ctz(positions);
+                        positions &= positions - 1;
+                        int result = eliminate(queue, trail, units[u][i], ALL_DIGITS & ~digits);
+                        if (result < 0) return -1;
+                        changed |= result;
+                    }
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// Função para aplicar as regras do nível escolhido até não haver mais mudanças
+// Cada mudança é empilhada no rastro; retorna 0 se encontrou contradição
+int propagate(MrvQueue *queue, Trail *trail, int level) {
+    SudokuState *state = queue->state;
+    if (level == PROP_NONE) return queue->head[0] == NO_CELL;
+
+    for (;;) {
+        if (queue->head[0] != NO_CELL) return 0;
+
+        // Únicos nus: são exatamente as células do balde 1 da fila MRV
+        while (queue->head[1] != NO_CELL) {
+            int pos = queue->head[1];
+            int num = lowest_digit(state_candidates(state, pos / SIZE, pos % SIZE));
+            if (!assign(queue, trail, pos, num)) return 0;
+        }
+        if (queue->empty_cells == 0) return 1;
+
+        // Regras mais caras só rodam quando as mais baratas não mudam nada
+        int result = hidden_singles(queue, trail);
+        if (result == 0 && level >= PROP_INTERSECTIONS) result = intersections(queue, trail);
+        if (result == 0 && level >= PROP_PAIRS) result = naked_subsets(queue, trail, 2);
+        if (result == 0 && level >= PROP_PAIRS) result = hidden_subsets(queue, trail, 2);
+        if (result == 0 && level >= PROP_TRIPLES) result = naked_subsets(queue, trail, 3);
+        if (result == 0 && level >= PROP_TRIPLES) result = hidden_subsets(queue, trail, 3);
+
+        if (result < 0) return 0;
+        if (result == 0) return 1; // Ponto fixo
+    }
+}
+
+// Função para desfazer as entradas do rastro acima de mark, na ordem inversa
+void unpropagate(MrvQueue *queue, Trail *trail, int mark) {
+    while (trail->len > mark) {
+        TrailEntry entry = trail->entries[--trail->len];
+        if (entry.removed == 0) mrv_undo(queue, entry.pos);
+        else mrv_restore(queue, entry.pos, entry.removed);
+    }
+}
\ No newline at end of file
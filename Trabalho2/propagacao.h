@@ -0,0 +1,39 @@
+#ifndef PROPAGACAO_H
+#define PROPAGACAO_H
+
+#include "mrv.h"
+
+// Níveis de propagação, cada um inclui os anteriores
+#define PROP_NONE 0           // só a busca
+#define PROP_SINGLES 1        // únicos nus e escondidos
+#define PROP_INTERSECTIONS 2  // pares apontadores e redução bloco-linha
+#define PROP_PAIRS 3          // pares nus e escondidos
+#define PROP_TRIPLES 4        // trincas nuas e escondidas
+#define PROP_MAX PROP_TRIPLES
+
+// Entrada do rastro: removed == 0 indica célula preenchida; caso contrário, candidatos eliminados
+typedef struct {
+    int pos;
+    Mask removed;
+} TrailEntry;
+
+// Cada célula é preenchida no máximo uma vez e perde no máximo SIZE candidatos em um caminho da busca
+#define TRAIL_CAPACITY (CELLS * (SIZE + 1))
+
+typedef struct {
+    TrailEntry entries[TRAIL_CAPACITY];
+    int len;
+    long filled;   // total de células preenchidas pela propagação (não diminui ao desfazer)
+} Trail;
+
+// Estatísticas de uma resolução
+typedef struct {
+    long filled;   // células preenchidas pela propagação (inclusive as desfeitas no backtracking)
+    long nodes;    // tentativas feitas pela busca
+} SolveStats;
+
+int trail_place(MrvQueue *queue, Trail *trail, int pos, int num);
+int propagate(MrvQueue *queue, Trail *trail, int level);
+void unpropagate(MrvQueue *queue, Trail *trail, int mark);
+
+#endif
\ No newline at end of file
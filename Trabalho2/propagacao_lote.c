@@ -0,0 +1,142 @@
+#include "propagacao_lote.h"
+
+// Contagem saturada em bits: após a chamada, *once tem as lanes em que o candidato apareceu
+// ao menos uma vez e *twice as lanes em que apareceu duas ou mais
+static inline void count_lanes(Lanes word, Lanes *once, Lanes *twice) {
+    *twice |= *once & word;
+    *once |= word;
+}
+
+// Função para montar o lote com até BATCH_LANES Sudokus
+void lanes_load(LaneBatch *batch, int grids[][SIZE][SIZE], int count) {
+    init_tables();
+    batch->active = (count >= BATCH_LANES) ? ~(Lanes)0 : LANE_BIT(count) - 1;
+    batch->failed = 0;
+    batch->solved = 0;
+
+    // Um número dado deixa só o seu candidato na célula; a propagação cuida dos vizinhos.
+    // Os Sudokus são lidos um de cada vez (acesso sequencial) e propagated guarda,
+    // por enquanto, as lanes em que a célula foi dada.
+    for (int pos = 0; pos < CELLS; pos++) {
+        batch->propagated[pos] = 0;
+        for (int d = 0; d < SIZE; d++) batch->candidates[pos][d] = 0;
+    }
+    for (int lane = 0; lane < count; lane++) {
+        const int *cells = &grids[lane][0][0];
+        for (int pos = 0; pos < CELLS; pos++) {
+            int num = cells[pos];
+            if (num == 0) continue;
+            if (num < 1 || num > SIZE) {
+                batch->failed |= LANE_BIT(lane);
+                continue;
+            }
+            batch->propagated[pos] |= LANE_BIT(lane);
+            batch->candidates[pos][num - 1] |= LANE_BIT(lane);
+        }
+    }
+    for (int pos = 0; pos < CELLS; pos++) {
+        Lanes open = batch->active & ~batch->propagated[pos];
+        for (int d = 0; d < SIZE; d++) batch->candidates[pos][d] |= open;
+        batch->propagated[pos] = 0;
+    }
+}
+
+// Únicos nus: cada célula com um só candidato retira o dígito dos vizinhos
+// Retorna as lanes que mudaram
+static Lanes naked_singles(LaneBatch *batch) {
+    Lanes changed = 0;
+    for (int pos = 0; pos < CELLS; pos++) {
+        Lanes once = 0, twice = 0;
+        for (int d = 0; d < SIZE; d++) count_lanes(batch->candidates[pos][d], &once, &twice);
+        batch->failed |= batch->active & ~once; // Célula sem candidatos
+
+        // Só as lanes em que a célula acabou de ficar com um candidato
+        Lanes single = once & ~twice & ~batch->propagated[pos];
+        if (!single) continue;
+        batch->propagated[pos] |= single;
+
+        for (int d = 0; d < SIZE; d++) {
+            Lanes placed = single & batch->candidates[pos][d];
+            if (!placed) continue;
+            for (int i = 0; i < NUM_PEERS; i++) {
+                Lanes *word = &batch->candidates[peers[pos][i]][d];
+                changed |= *word & placed;
+                *word &= ~placed;
+            }
+        }
+    }
+    return changed;
+}
+
+// Únicos escondidos: dígito que só cabe em uma célula da unidade fica sozinho nela
+// Retorna as lanes que mudaram
+static Lanes hidden_singles(LaneBatch *batch) {
+    Lanes changed = 0;
+    for (int u = 0; u < NUM_UNITS; u++) {
+        for (int d = 0; d < SIZE; d++) {
+            Lanes once = 0, twice = 0, placed = 0;
+            for (int i = 0; i < SIZE; i++) {
+                int pos = units[u][i];
+                count_lanes(batch->candidates[pos][d], &once, &twice);
+                placed |= batch->candidates[pos][d] & batch->propagated[pos];
+            }
+            batch->failed |= batch->active & ~once; // Dígito sem lugar na unidade
+
+            // Lanes em que o dígito já está em uma célula resolvida não têm o que mudar
+            Lanes hidden = once & ~twice & ~placed;
+            if (!hidden) continue;
+            for (int i = 0; i < SIZE; i++) {
+                int pos = units[u][i];
+                Lanes here = hidden & batch->candidates[pos][d];
+                if (!here) continue;
+                for (int other = 0; other < SIZE; other++) {
+                    if (other == d) continue;
+                    changed |= batch->candidates[pos][other] & here;
+                    batch->candidates[pos][other] &= ~here;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// Função para propagar únicos nus e escondidos em todos os Sudokus do lote até nada mudar
+// Ao final, failed e solved indicam os Sudokus que não precisam de busca
+void lanes_propagate(LaneBatch *batch) {
+    Lanes changed;
+    do {
+        changed = naked_singles(batch);
+        changed |= hidden_singles(batch);
+        changed &= batch->active & ~batch->failed;
+    } while (changed);
+
+    // Resolvido: todas as células com exatamente um candidato
+    Lanes solved = batch->active & ~batch->failed;
+    for (int pos = 0; pos < CELLS && solved; pos++) {
+        Lanes once = 0, twice = 0;
+        for (int d = 0; d < SIZE; d++) count_lanes(batch->candidates[pos][d], &once, &twice);
+        solved &= once & ~twice;
+    }
+    batch->solved = solved;
+}
+
+// Função para copiar para as grades as células que a propagação determinou
+// Só escreve nos Sudokus sem contradição; grids tem as mesmas posições usadas em lanes_load
+void lanes_extract(const LaneBatch *batch, int grids[][SIZE][SIZE]) {
+    Lanes valid = batch->active & ~batch->failed;
+    for (int pos = 0; pos < CELLS; pos++) {
+        Lanes once = 0, twice = 0;
+        for (int d = 0; d < SIZE; d++) count_lanes(batch->candidates[pos][d], &once, &twice);
+        Lanes single = once & ~twice & valid;
+
+        for (int d = 0; d < SIZE && single; d++) {
+            Lanes lanes = single & batch->candidates[pos][d];
+            single &= ~lanes;
+            while (lanes) {
+                int lane = __builtin_ctzll(lanes);
+                lanes &= lanes - 1;
+                grids[lane][pos / SIZE][pos % SIZE] = d + 1;
+            }
+        }
+    }
+}
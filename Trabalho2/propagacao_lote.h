@@ -0,0 +1,28 @@
+#ifndef PROPAGACAO_LOTE_H
+#define PROPAGACAO_LOTE_H
+
+#include <stdint.h>
+#include "estado.h"
+
+// Propagação em lote, com os Sudokus "fatiados em bits": cada palavra de 64 bits guarda
+// o mesmo candidato de BATCH_LANES Sudokus diferentes, um por bit (lane). Uma operação
+// bit a bit avança a propagação de todos os Sudokus do lote ao mesmo tempo.
+#define BATCH_LANES 64
+
+typedef uint64_t Lanes;
+
+#define LANE_BIT(lane) ((Lanes)1 << (lane))
+
+typedef struct {
+    Lanes candidates[CELLS][SIZE];  // bit p ligado se o dígito d + 1 ainda cabe na célula do Sudoku p
+    Lanes propagated[CELLS];        // Sudokus em que o único nu da célula já foi retirado dos vizinhos
+    Lanes active;                   // Sudokus presentes no lote
+    Lanes failed;                   // contradição encontrada: sem solução
+    Lanes solved;                   // resolvidos só pela propagação
+} LaneBatch;
+
+void lanes_load(LaneBatch *batch, int grids[][SIZE][SIZE], int count);
+void lanes_propagate(LaneBatch *batch);
+void lanes_extract(const LaneBatch *batch, int grids[][SIZE][SIZE]);
+
+#endif
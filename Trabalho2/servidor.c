@@ -0,0 +1,165 @@
+#include "servidor.h"
+#include "heuristica.h"
+#include "leitura.h"
+#include "escrita.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+// Dados compartilhados pelas threads de atendimento
+typedef struct {
+    int listener;
+    int level;
+} Server;
+
+// Caminho do socket, removido quando o servidor é encerrado por um sinal
+static const char *bound_path = NULL;
+
+// Trata SIGINT e SIGTERM: remove o socket e encerra (unlink e _exit podem ser chamados aqui)
+static void handle_stop(int signal_number) {
+    (void)signal_number;
+    if (bound_path) unlink(bound_path);
+    _exit(EXIT_SUCCESS);
+}
+
+// Envia a resposta inteira; retorna 0 se o cliente fechou a conexão
+static int send_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        data += n;
+        length -= n;
+    }
+    return 1;
+}
+
+// Função para atender um cliente até ele fechar a conexão
+// Cada Sudoku é respondido assim que é resolvido, com uma única escrita; se a conexão fechar
+// no meio de um Sudoku, ele não é resolvido e a resposta é um erro
+static void serve_client(FILE *input, int output, int level) {
+    PuzzleReader reader;
+    if (!reader_open_file(&reader, input)) {
+        const char *message = "erro cabecalho-binario-invalido\n";
+        send_all(output, message, strlen(message));
+        reader_close(&reader);
+        return;
+    }
+
+    int grid[SIZE][SIZE];
+    char response[64 + PUZZLE_TEXT_MAX];
+    SolveStats stats;
+    while (reader_next(&reader, grid) && !reader.truncated) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int solved = heuristic_solve(grid, level, &stats) || backtracking_solve(grid);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+        size_t length = sprintf(response, "%s %.6f\n", solved ? "resolvido" : "sem-solucao", elapsed);
+        length += format_sudoku(response + length, grid);
+        response[length++] = '\n';
+        if (!send_all(output, response, length)) break;
+    }
+    if (reader.truncated) {
+        const char *message = "erro sudoku-incompleto\n";
+        send_all(output, message, strlen(message));
+    }
+    reader_close(&reader);
+}
+
+// Laço de uma thread de atendimento: espera uma conexão, atende e volta a esperar
+// Se o accept falhar (sem descritores livres, por exemplo), a thread espera um pouco antes de
+// tentar de novo, para não girar em falso enchendo a saída de erro
+static void *serve_connections(void *arg) {
+    Server *server = arg;
+    const struct timespec backoff = {0, 100 * 1000 * 1000}; // 100 ms
+    for (;;) {
+        int client = accept(server->listener, NULL, NULL);
+        if (client < 0) {
+            if (errno != EINTR) {
+                perror("Erro ao aceitar conexão");
+                nanosleep(&backoff, NULL);
+            }
+            continue;
+        }
+        FILE *input = fdopen(client, "r");
+        if (!input) {
+            perror("Erro ao abrir a conexão");
+            close(client);
+            continue;
+        }
+        serve_client(input, client, server->level); // Fechar a leitura fecha a conexão
+    }
+    return NULL;
+}
+
+// Função para rodar o servidor; só retorna no modo "-", quando a entrada padrão termina
+void serve(const char *socket_path, int level, int workers) {
+    init_tables(); // As tabelas de vizinhos são montadas uma vez, antes de criar as threads
+
+    // Um cliente que fecha a conexão no meio de uma resposta não derruba o servidor
+    struct sigaction ignore;
+    memset(&ignore, 0, sizeof(ignore));
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPIPE, &ignore, NULL);
+
+    if (strcmp(socket_path, "-") == 0) {
+        serve_client(stdin, STDOUT_FILENO, level);
+        return;
+    }
+
+    struct sockaddr_un address;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Caminho do socket muito longo: '%s'.\n", socket_path);
+        exit(EXIT_FAILURE);
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("Erro ao criar o socket");
+        exit(EXIT_FAILURE);
+    }
+    // Um socket deixado por uma execução anterior é substituído; outros arquivos não são tocados
+    struct stat info;
+    if (stat(socket_path, &info) == 0 && S_ISSOCK(info.st_mode)) unlink(socket_path);
+    if (bind(listener, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0) {
+        perror("Erro ao abrir o socket");
+        exit(EXIT_FAILURE);
+    }
+
+    bound_path = socket_path;
+    struct sigaction stop;
+    memset(&stop, 0, sizeof(stop));
+    stop.sa_handler = handle_stop;
+    sigemptyset(&stop.sa_mask);
+    sigaction(SIGINT, &stop, NULL);
+    sigaction(SIGTERM, &stop, NULL);
+
+    // As threads ficam prontas esperando conexões; a thread atual também atende
+    Server server = {listener, level};
+    for (int w = 1; w < workers; w++) {
+        pthread_t id;
+        if (pthread_create(&id, NULL, serve_connections, &server) != 0) {
+            perror("Erro ao criar thread de atendimento");
+            exit(EXIT_FAILURE);
+        }
+        pthread_detach(id);
+    }
+    fprintf(stderr, "Servidor ouvindo em '%s' com %d threads.\n", socket_path, workers);
+    serve_connections(&server);
+}
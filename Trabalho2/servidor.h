@@ -0,0 +1,19 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+// Modo servidor da heurística (opção -d): o processo fica no ar e resolve Sudokus pedidos por
+// clientes em um socket Unix local ("-" atende um único cliente pela entrada e saída padrão).
+//
+// Protocolo: o cliente manda Sudokus no formato de texto ou no binário, como num arquivo de
+// entrada, e pode mandar vários na mesma conexão. Para cada Sudoku o servidor responde com
+//   resolvido <segundos>      (ou sem-solucao <segundos>)
+//   <a grade, no formato de texto>
+//   <linha em branco>
+// onde <segundos> é o tempo gasto na resolução. A conexão termina quando o cliente a fecha.
+// Erros são respondidos com uma linha "erro <motivo>": cabecalho-binario-invalido, ou
+// sudoku-incompleto quando a conexão fecha no meio de um Sudoku (que não é resolvido).
+// As threads de atendimento e as tabelas de vizinhos são criadas uma vez, ao iniciar.
+
+void serve(const char *socket_path, int level, int workers);
+
+#endif
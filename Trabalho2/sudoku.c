@@ -0,0 +1,90 @@
+#include "sudoku.h"
+#include "busca.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+// Contexto de resolução: a busca inteira (pilha, rastro e baldes) fica aqui dentro,
+// então resolver uma grade não aloca nada
+struct SudokuContext {
+    Search search;
+    int level;
+    long max_nodes;   // 0 = sem limite
+    SolveStats stats; // da última grade resolvida
+};
+
+// As tabelas de vizinhos são globais e montadas uma única vez, mesmo com várias threads criando
+// contextos ao mesmo tempo
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+// Função para criar um contexto com o nível de propagação dado
+// Retorna SUDOKU_OK e o contexto em *context, ou um código de erro
+int sudoku_create(SudokuContext **context, int level) {
+    if (!context) return SUDOKU_ERR_ARGUMENT;
+    *context = NULL;
+    if (level < PROP_NONE || level > PROP_MAX) return SUDOKU_ERR_ARGUMENT;
+    if (pthread_once(&tables_once, init_tables) != 0) return SUDOKU_ERR_MEMORY;
+
+    SudokuContext *created = malloc(sizeof(SudokuContext));
+    if (!created) return SUDOKU_ERR_MEMORY;
+    created->level = level;
+    created->max_nodes = 0;
+    created->stats.filled = created->stats.nodes = 0;
+    *context = created;
+    return SUDOKU_OK;
+}
+
+// Função para liberar o contexto
+void sudoku_destroy(SudokuContext *context) {
+    free(context);
+}
+
+// Função para limitar as tentativas de cada sudoku_solve (0 = sem limite)
+int sudoku_set_node_limit(SudokuContext *context, long max_nodes) {
+    if (!context || max_nodes < 0) return SUDOKU_ERR_ARGUMENT;
+    context->max_nodes = max_nodes;
+    return SUDOKU_OK;
+}
+
+// Função para resolver a grade no lugar, com a heurística MRV e a propagação do contexto
+// Se não resolver, a grade volta exatamente como estava
+int sudoku_solve(SudokuContext *context, int grid[SUDOKU_CELLS]) {
+    if (!context || !grid) return SUDOKU_ERR_ARGUMENT;
+
+    Search *search = &context->search;
+    int (*cells)[SIZE] = (int (*)[SIZE])grid;
+    int status = search_init(search, cells, SELECT_MRV, context->level);
+    if (status == SEARCH_RUNNING) status = search_run(search, context->max_nodes);
+    search_stats(search, &context->stats);
+    if (status == SEARCH_SOLVED) return SUDOKU_OK;
+    if (status == SEARCH_FAILED) {
+        // A busca trata grade inválida e grade sem solução do mesmo jeito; só neste caso a
+        // grade (que a busca já devolveu como estava) é conferida de novo para separá-las
+        SudokuState check;
+        return state_init(&check, cells) ? SUDOKU_UNSOLVABLE : SUDOKU_ERR_INVALID;
+    }
+
+    unpropagate(&search->queue, &search->trail, 0); // Parou no limite: devolve a grade original
+    return SUDOKU_LIMIT;
+}
+
+// Função para obter as estatísticas da última grade: células preenchidas pela propagação
+// e tentativas da busca (qualquer um dos ponteiros pode ser NULL)
+int sudoku_stats(const SudokuContext *context, long *filled, long *nodes) {
+    if (!context) return SUDOKU_ERR_ARGUMENT;
+    if (filled) *filled = context->stats.filled;
+    if (nodes) *nodes = context->stats.nodes;
+    return SUDOKU_OK;
+}
+
+// Função para descrever um código de retorno
+const char *sudoku_strerror(int status) {
+    switch (status) {
+        case SUDOKU_OK: return "resolvido";
+        case SUDOKU_UNSOLVABLE: return "sem solução";
+        case SUDOKU_LIMIT: return "limite de tentativas atingido";
+        case SUDOKU_ERR_ARGUMENT: return "argumento inválido";
+        case SUDOKU_ERR_INVALID: return "grade inválida";
+        case SUDOKU_ERR_MEMORY: return "falta de memória";
+        default: return "código desconhecido";
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef SUDOKU_H
+#define SUDOKU_H
+
+// libsudoku: o resolvedor da heurística como biblioteca, para ligar em outros programas C ou C++
+// (make libsudoku gera libsudoku.a e libsudoku.so; ligue também com -pthread).
+//
+// Cada contexto guarda todo o estado de uma busca. Ele é criado uma vez e resolve quantas grades
+// for preciso sem alocar memória e sem escrever nada na tela; os erros voltam como códigos.
+// Contextos diferentes podem ser usados ao mesmo tempo em threads diferentes; um mesmo contexto
+// não pode ser usado por duas threads ao mesmo tempo.
+//
+// A grade tem SUDOKU_CELLS inteiros em ordem de linha e coluna, com 0 nas células vazias.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define SUDOKU_API __attribute__((visibility("default")))
+#else
+#define SUDOKU_API
+#endif
+
+#define SUDOKU_ORDER 9
+#define SUDOKU_CELLS (SUDOKU_ORDER * SUDOKU_ORDER)
+
+// Níveis de propagação, do mais simples ao mais forte (os mesmos da opção -p da heurística)
+#define SUDOKU_LEVEL_NONE 0
+#define SUDOKU_LEVEL_SINGLES 1
+#define SUDOKU_LEVEL_INTERSECTIONS 2
+#define SUDOKU_LEVEL_PAIRS 3
+#define SUDOKU_LEVEL_TRIPLES 4
+
+// Códigos de retorno: os positivos são resultados da busca, os negativos são erros de uso
+#define SUDOKU_OK 0                // resolvido; a grade foi preenchida
+#define SUDOKU_UNSOLVABLE 1        // a grade é válida, mas não tem solução
+#define SUDOKU_LIMIT 2             // a busca parou no limite de tentativas
+#define SUDOKU_ERR_ARGUMENT (-1)   // ponteiro nulo ou nível fora do intervalo
+#define SUDOKU_ERR_INVALID (-2)    // valor fora de 0..9 ou repetido numa linha, coluna ou bloco
+#define SUDOKU_ERR_MEMORY (-3)     // falta de memória ao criar o contexto
+
+typedef struct SudokuContext SudokuContext;
+
+SUDOKU_API int sudoku_create(SudokuContext **context, int level);
+SUDOKU_API void sudoku_destroy(SudokuContext *context);
+SUDOKU_API int sudoku_set_node_limit(SudokuContext *context, long max_nodes);
+SUDOKU_API int sudoku_solve(SudokuContext *context, int grid[SUDOKU_CELLS]);
+SUDOKU_API int sudoku_stats(const SudokuContext *context, long *filled, long *nodes);
+SUDOKU_API const char *sudoku_strerror(int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
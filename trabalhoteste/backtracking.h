@@ -4,19 +4,10 @@
 #include <sys/time.h>
 #include <math.h>
 #include <time.h>
+#include <stddef.h>
+#include "lote.h"
 
-#define EMPTY 'v'
-
-typedef struct {
-    int row;
-    int col;
-    int possibilities;
-} Cell;
-
-int is_valid(int **grid, int size, int row, int col, int num);
-int solve_sudoku(int **grid, int size);
-int load_sudokus(const char *filename, int ****puzzles, int **sizes, int *puzzle_count);
-void save_sudokus(const char *filename, int ***puzzles, int *sizes, int puzzle_count);
-void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end);
+int solve_sudoku(uint8_t *grid, int size);
+void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end, size_t memory);
 
 #endif
\ No newline at end of file
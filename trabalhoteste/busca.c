@@ -0,0 +1,75 @@
+#include "busca.h"
+
+// Escolhe a próxima célula vazia e seus candidatos; retorna -1 se a grade estiver completa
+static int choose_cell(const Search *search, Mask *candidates) {
+    const MaskState *state = &search->state;
+    if (search->choose) return search->choose(state, candidates);
+
+    // Em ordem: continua a partir da última célula decidida
+    int cells = state->geometry->cells;
+    int pos = search->depth > 0 ? search->stack[search->depth - 1].pos + 1 : 0;
+    while (pos < cells && state->grid[pos] != 0) pos++;
+    if (pos == cells) return -1;
+    *candidates = mask_candidates(state, pos);
+    return pos;
+}
+
+// Função para preparar a busca sobre a grade
+// Retorna SEARCH_FAILED se o tamanho não tiver geometria ou se os números dados se repetirem
+int search_init(Search *search, uint8_t *grid, int size, CellChooser choose) {
+    search->choose = choose;
+    search->depth = 0;
+    search->descend = 1;
+    search->nodes = 0;
+    search->status = mask_state_init(&search->state, grid, size) ? SEARCH_RUNNING : SEARCH_FAILED;
+    return search->status;
+}
+
+// Função para avançar a busca até resolver, esgotar as opções ou fazer max_nodes tentativas
+// Com max_nodes == 0 não há limite. Retorna SEARCH_RUNNING se parou pelo limite; nesse ponto a
+// célula da decisão do topo está vazia, e chamar de novo retoma exatamente do mesmo ponto.
+// Se não houver solução, a grade volta como estava
+int search_run(Search *search, long max_nodes) {
+    MaskState *state = &search->state;
+    long budget_end = search->nodes + max_nodes;
+
+    while (search->status == SEARCH_RUNNING) {
+        if (search->descend) {
+            Mask candidates = 0;
+            int pos = choose_cell(search, &candidates);
+            if (pos == -1) {
+                search->status = SEARCH_SOLVED;
+                break;
+            }
+            search->descend = 0;
+            if (candidates) {
+                Decision *decision = &search->stack[search->depth++];
+                decision->pos = pos;
+                decision->remaining = candidates;
+            }
+            // Sem candidatos: volta direto para a próxima opção da decisão anterior
+        }
+
+        if (search->depth == 0) {
+            search->status = SEARCH_FAILED;
+            break;
+        }
+
+        // Desfaz a tentativa anterior desta decisão (as de cima já foram desfeitas)
+        Decision *decision = &search->stack[search->depth - 1];
+        if (state->grid[decision->pos] != 0) mask_undo(state, decision->pos);
+        if (!decision->remaining) {
+            search->depth--;
+            continue;
+        }
+
+        if (max_nodes > 0 && search->nodes >= budget_end) break; // Pausa
+
+        int num = lowest_digit(decision->remaining);
+        decision->remaining &= decision->remaining - 1;
+        search->nodes++;
+        mask_place(state, decision->pos, num);
+        search->descend = 1;
+    }
+    return search->status;
+}
@@ -0,0 +1,37 @@
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include "mascaras.h"
+
+#define MAX_CELLS (MAX_GRID_SIZE * MAX_GRID_SIZE)
+
+// Situação da busca
+#define SEARCH_RUNNING 0
+#define SEARCH_SOLVED 1
+#define SEARCH_FAILED 2
+
+// Decisão empilhada: célula escolhida e candidatos ainda não tentados
+// Sem propagação, cada decisão coloca um único número, então a própria pilha serve de rastro:
+// voltar a uma decisão é apagar as células das decisões acima dela
+typedef struct {
+    int pos;
+    Mask remaining;
+} Decision;
+
+// Busca iterativa com pilha explícita sobre o estado de máscaras; todo o estado fica nesta
+// estrutura (cerca de 66 KB), então a profundidade não depende da pilha de chamadas e a busca
+// pode ser pausada, inspecionada e retomada
+typedef struct {
+    MaskState state;
+    CellChooser choose;   // escolha da MRV; NULL = primeira célula vazia em ordem
+    Decision stack[MAX_CELLS];
+    int depth;
+    int descend;          // 1 se a próxima iteração deve escolher uma nova célula
+    int status;
+    long nodes;
+} Search;
+
+int search_init(Search *search, uint8_t *grid, int size, CellChooser choose);
+int search_run(Search *search, long max_nodes);
+
+#endif
@@ -0,0 +1,261 @@
+#include "busca_paralela.h"
+#include "busca.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Busca MRV paralela com roubo de trabalho. Cada tarefa é uma subárvore da busca, guardada
+// como uma cópia da grade (as máscaras são refeitas a partir dela) e explorada pela busca
+// iterativa de busca.h. Cada thread tem sua fila: empilha e retira tarefas no fim (as mais
+// profundas) e as outras roubam do início (as mais próximas da raiz, que costumam ser as maiores).
+
+// Enquanto houver menos que threads * SPLIT_FACTOR tarefas nas filas, a thread doa as opções
+// ainda não tentadas da sua decisão mais rasa como tarefas
+#define SPLIT_FACTOR 2
+
+// Tentativas entre duas pausas da busca de uma tarefa; a cada pausa a thread confere se outra
+// já resolveu o Sudoku e se deve doar trabalho
+#define SLICE_NODES 64
+
+// Tarefa: a subárvore a explorar, dada pela grade com as escolhas já feitas (cells bytes)
+typedef uint8_t Task;
+
+// Fila de tarefas de uma thread; as posições [head, tail) estão ocupadas
+typedef struct {
+    pthread_mutex_t lock;
+    Task **items;
+    int head;
+    int tail;
+    int capacity;
+} TaskQueue;
+
+// Dados compartilhados por todas as threads da busca
+typedef struct {
+    int size;
+    int cells;
+    int threads;
+    TaskQueue *queues;
+    int queued;        // tarefas nas filas
+    int outstanding;   // tarefas nas filas ou em execução; a busca acaba quando chega a 0
+    int stop;          // 1 assim que alguma thread encontra a solução
+    uint8_t *solution;
+    pthread_mutex_t idle_lock;   // threads sem tarefa esperam em work_ready com este lock
+    pthread_cond_t work_ready;   // avisada quando chega tarefa, quando alguém resolve ou quando a árvore se esgota
+} SharedSearch;
+
+typedef struct {
+    SharedSearch *shared;
+    int id;
+    uint8_t *grid;     // grade de trabalho da thread
+    Search *search;    // busca da tarefa em execução
+    long nodes;
+    long tasks;
+    long steals;
+} Worker;
+
+// Acorda todas as threads paradas em work_ready (a busca acabou)
+static void wake_all(SharedSearch *shared) {
+    pthread_mutex_lock(&shared->idle_lock);
+    pthread_cond_broadcast(&shared->work_ready);
+    pthread_mutex_unlock(&shared->idle_lock);
+}
+
+static Task *new_task(const uint8_t *grid, int cells) {
+    Task *task = malloc(cells);
+    if (task) memcpy(task, grid, cells);
+    return task;
+}
+
+// Coloca a tarefa no fim da fila da thread e acorda uma thread parada; retorna 0 se faltar memória
+static int push_task(SharedSearch *shared, int id, Task *task) {
+    TaskQueue *queue = &shared->queues[id];
+    pthread_mutex_lock(&queue->lock);
+    if (queue->tail == queue->capacity) {
+        if (queue->head > 0) {
+            // Reaproveita o espaço liberado pelos roubos
+            memmove(queue->items, queue->items + queue->head, (queue->tail - queue->head) * sizeof(Task *));
+            queue->tail -= queue->head;
+            queue->head = 0;
+        } else {
+            int capacity = queue->capacity ? 2 * queue->capacity : 64;
+            Task **items = realloc(queue->items, capacity * sizeof(Task *));
+            if (!items) {
+                pthread_mutex_unlock(&queue->lock);
+                return 0;
+            }
+            queue->items = items;
+            queue->capacity = capacity;
+        }
+    }
+    __atomic_add_fetch(&shared->outstanding, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&shared->queued, 1, __ATOMIC_RELAXED);
+    queue->items[queue->tail++] = task;
+    pthread_mutex_unlock(&queue->lock);
+
+    // O aviso sai com idle_lock: uma thread que acabou de ver as filas vazias já está esperando
+    pthread_mutex_lock(&shared->idle_lock);
+    pthread_cond_signal(&shared->work_ready);
+    pthread_mutex_unlock(&shared->idle_lock);
+    return 1;
+}
+
+// Retira uma tarefa da fila: do fim se for a própria thread, do início se for um roubo
+static Task *take_task(SharedSearch *shared, int id, int steal) {
+    TaskQueue *queue = &shared->queues[id];
+    Task *task = NULL;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail) {
+        task = steal ? queue->items[queue->head++] : queue->items[--queue->tail];
+        if (queue->head == queue->tail) queue->head = queue->tail = 0;
+        __atomic_sub_fetch(&shared->queued, 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return task;
+}
+
+// Doa como tarefas as opções ainda não tentadas da decisão mais rasa da busca pausada
+// A grade de cada tarefa é a grade atual sem as células das decisões daquela para cima,
+// com a opção doada na célula da decisão
+static void donate_options(Worker *worker) {
+    SharedSearch *shared = worker->shared;
+    Search *search = worker->search;
+    int level = 0;
+    while (level < search->depth && !search->stack[level].remaining) level++;
+    if (level == search->depth) return;
+
+    Decision *decision = &search->stack[level];
+    while (decision->remaining) {
+        Task *task = new_task(search->state.grid, shared->cells);
+        if (!task) break; // Sem memória: as opções restantes ficam com esta thread
+        for (int i = level; i < search->depth; i++) task[search->stack[i].pos] = 0;
+        task[decision->pos] = (uint8_t)lowest_digit(decision->remaining);
+        if (!push_task(shared, worker->id, task)) {
+            free(task);
+            break;
+        }
+        decision->remaining &= decision->remaining - 1;
+    }
+}
+
+// Explora a subárvore da tarefa que está na grade da thread; retorna 1 com a solução nela
+// A busca roda em fatias de SLICE_NODES tentativas e para quando outra thread resolve
+static int run_task(Worker *worker) {
+    SharedSearch *shared = worker->shared;
+    Search *search = worker->search;
+    int status = search_init(search, worker->grid, shared->size, mask_best_cell);
+    while (status == SEARCH_RUNNING && !__atomic_load_n(&shared->stop, __ATOMIC_RELAXED)) {
+        if (__atomic_load_n(&shared->queued, __ATOMIC_RELAXED) < shared->threads * SPLIT_FACTOR) {
+            donate_options(worker);
+        }
+        status = search_run(search, SLICE_NODES);
+    }
+    worker->nodes += search->nodes;
+    return status == SEARCH_SOLVED;
+}
+
+// Laço de cada thread: executa tarefas da própria fila e, quando ela esvazia, rouba das outras
+// Sem tarefa em nenhuma fila, a thread dorme em work_ready em vez de girar sobre as filas
+static void *work(void *arg) {
+    Worker *worker = arg;
+    SharedSearch *shared = worker->shared;
+
+    while (!__atomic_load_n(&shared->stop, __ATOMIC_ACQUIRE)) {
+        Task *task = take_task(shared, worker->id, 0);
+        for (int i = 1; !task && i < shared->threads; i++) {
+            task = take_task(shared, (worker->id + i) % shared->threads, 1);
+            if (task) worker->steals++;
+        }
+        if (!task) {
+            pthread_mutex_lock(&shared->idle_lock);
+            while (!__atomic_load_n(&shared->stop, __ATOMIC_ACQUIRE) &&
+                   __atomic_load_n(&shared->queued, __ATOMIC_SEQ_CST) == 0 &&
+                   __atomic_load_n(&shared->outstanding, __ATOMIC_SEQ_CST) > 0) {
+                pthread_cond_wait(&shared->work_ready, &shared->idle_lock);
+            }
+            pthread_mutex_unlock(&shared->idle_lock);
+            if (__atomic_load_n(&shared->outstanding, __ATOMIC_SEQ_CST) == 0) break; // Árvore esgotada
+            continue;
+        }
+
+        worker->tasks++;
+        memcpy(worker->grid, task, shared->cells);
+        free(task);
+
+        if (run_task(worker) && !__atomic_exchange_n(&shared->stop, 1, __ATOMIC_ACQ_REL)) {
+            memcpy(shared->solution, worker->grid, shared->cells); // Primeira thread a resolver
+            wake_all(shared);
+        }
+        if (__atomic_sub_fetch(&shared->outstanding, 1, __ATOMIC_SEQ_CST) == 0) wake_all(shared);
+    }
+    return NULL;
+}
+
+// Função para resolver o Sudoku com a busca MRV dividida entre threads
+// Assim que uma thread encontra a solução, todas param; retorna 1 com a grade resolvida
+int parallel_solve(uint8_t *grid, int size, int threads, ParallelStats *stats) {
+    stats->nodes = stats->tasks = stats->steals = 0;
+
+    MaskState check;
+    if (!mask_state_init(&check, grid, size)) return 0; // Tamanho inválido ou números repetidos
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    SharedSearch shared = {.size = size, .cells = size * size, .threads = threads};
+    Worker workers[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    shared.queues = calloc(threads, sizeof(TaskQueue));
+    shared.solution = malloc(shared.cells);
+    uint8_t *grids = malloc((size_t)threads * shared.cells);
+    Search *searches = malloc(threads * sizeof(Search)); // Grandes demais para a pilha de parallel_solve
+    Task *root = new_task(grid, shared.cells);
+    if (!shared.queues || !shared.solution || !grids || !searches || !root) {
+        perror("Erro ao alocar a busca paralela");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_mutex_init(&shared.idle_lock, NULL);
+    pthread_cond_init(&shared.work_ready, NULL);
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_init(&shared.queues[t].lock, NULL);
+        workers[t] = (Worker){&shared, t, grids + (size_t)t * shared.cells, &searches[t], 0, 0, 0};
+    }
+    if (!push_task(&shared, 0, root)) {
+        perror("Erro ao alocar a busca paralela");
+        exit(EXIT_FAILURE);
+    }
+
+    // A thread atual é a thread 0
+    int created = 1;
+    for (; created < threads; created++) {
+        if (pthread_create(&ids[created], NULL, work, &workers[created]) != 0) {
+            fprintf(stderr, "Erro ao criar thread; continuando com %d.\n", created);
+            break;
+        }
+    }
+    work(&workers[0]);
+    for (int t = 1; t < created; t++) pthread_join(ids[t], NULL);
+
+    // Tarefas que sobraram quando a solução foi encontrada
+    for (int t = 0; t < threads; t++) {
+        TaskQueue *queue = &shared.queues[t];
+        for (int i = queue->head; i < queue->tail; i++) free(queue->items[i]);
+        free(queue->items);
+        pthread_mutex_destroy(&queue->lock);
+        stats->nodes += workers[t].nodes;
+        stats->tasks += workers[t].tasks;
+        stats->steals += workers[t].steals;
+    }
+
+    pthread_cond_destroy(&shared.work_ready);
+    pthread_mutex_destroy(&shared.idle_lock);
+
+    int solved = shared.stop;
+    if (solved) memcpy(grid, shared.solution, shared.cells);
+
+    free(shared.queues);
+    free(shared.solution);
+    free(grids);
+    free(searches);
+    return solved;
+}
@@ -0,0 +1,18 @@
+#ifndef BUSCA_PARALELA_H
+#define BUSCA_PARALELA_H
+
+#include <stdint.h>
+
+// Maior número de threads aceito pela opção -j
+#define MAX_THREADS 256
+
+// Estatísticas de uma busca paralela, somadas sobre todas as threads
+typedef struct {
+    long nodes;    // tentativas feitas pela busca
+    long tasks;    // subárvores executadas como tarefas
+    long steals;   // tarefas roubadas da fila de outra thread
+} ParallelStats;
+
+int parallel_solve(uint8_t *grid, int size, int threads, ParallelStats *stats);
+
+#endif
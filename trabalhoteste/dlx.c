@@ -0,0 +1,194 @@
+#include "dlx.h"
+#include "geometria.h"
+#include <stdlib.h>
+
+// Colunas da cobertura exata, para uma grade size x size:
+//   célula (linha, coluna) preenchida, número na linha, número na coluna e número no bloco.
+// Cada opção (linha, coluna, número) cobre exatamente uma coluna de cada grupo.
+// O nó 0 é a raiz e os nós 1..4*size*size são os cabeçalhos das colunas.
+
+// Função para zerar a arena antes do primeiro uso
+void dlx_init(DlxArena *arena) {
+    arena->left = arena->right = arena->up = arena->down = NULL;
+    arena->column = arena->row_id = arena->col_size = arena->solution = NULL;
+    arena->node_capacity = 0;
+    arena->size_capacity = 0;
+}
+
+// Função para liberar os vetores da arena
+void dlx_free(DlxArena *arena) {
+    free(arena->left);
+    free(arena->right);
+    free(arena->up);
+    free(arena->down);
+    free(arena->column);
+    free(arena->row_id);
+    free(arena->col_size);
+    free(arena->solution);
+    dlx_init(arena);
+}
+
+// Função para garantir espaço para grades de até size x size
+// Deve ser chamada uma vez com o maior tamanho do lote; retorna 0 se faltar memória
+int dlx_reserve(DlxArena *arena, int size) {
+    if (size <= arena->size_capacity) return 1;
+
+    int columns = 4 * size * size;
+    int nodes = 1 + columns + 4 * size * size * size;
+    dlx_free(arena);
+
+    arena->left = malloc(nodes * sizeof(int));
+    arena->right = malloc(nodes * sizeof(int));
+    arena->up = malloc(nodes * sizeof(int));
+    arena->down = malloc(nodes * sizeof(int));
+    arena->column = malloc(nodes * sizeof(int));
+    arena->row_id = malloc(nodes * sizeof(int));
+    arena->col_size = malloc((columns + 1) * sizeof(int));
+    arena->solution = malloc(size * size * sizeof(int));
+    if (!arena->left || !arena->right || !arena->up || !arena->down || !arena->column ||
+        !arena->row_id || !arena->col_size || !arena->solution) {
+        dlx_free(arena);
+        return 0;
+    }
+
+    arena->node_capacity = nodes;
+    arena->size_capacity = size;
+    return 1;
+}
+
+// Função para calcular a memória reservada pela arena, em bytes
+size_t dlx_memory(const DlxArena *arena) {
+    size_t columns = 4 * (size_t)arena->size_capacity * arena->size_capacity;
+    size_t cells = (size_t)arena->size_capacity * arena->size_capacity;
+    return (6 * (size_t)arena->node_capacity + columns + 1 + cells) * sizeof(int);
+}
+
+// Remove a coluna da lista de cabeçalhos e as opções que a cobrem das demais colunas
+static void cover(DlxArena *a, int c) {
+    a->right[a->left[c]] = a->right[c];
+    a->left[a->right[c]] = a->left[c];
+    for (int i = a->down[c]; i != c; i = a->down[i]) {
+        for (int j = a->right[i]; j != i; j = a->right[j]) {
+            a->down[a->up[j]] = a->down[j];
+            a->up[a->down[j]] = a->up[j];
+            a->col_size[a->column[j]]--;
+        }
+    }
+}
+
+// Desfaz o cover, na ordem inversa
+static void uncover(DlxArena *a, int c) {
+    for (int i = a->up[c]; i != c; i = a->up[i]) {
+        for (int j = a->left[i]; j != i; j = a->left[j]) {
+            a->col_size[a->column[j]]++;
+            a->down[a->up[j]] = j;
+            a->up[a->down[j]] = j;
+        }
+    }
+    a->right[a->left[c]] = c;
+    a->left[a->right[c]] = c;
+}
+
+// Monta a matriz completa de opções para o tamanho dado
+static void build_matrix(DlxArena *a, const Geometry *geometry) {
+    int size = geometry->size;
+    int columns = 4 * size * size;
+    int cells = size * size;
+
+    for (int c = 0; c <= columns; c++) {
+        a->left[c] = (c == 0) ? columns : c - 1;
+        a->right[c] = (c == columns) ? 0 : c + 1;
+        a->up[c] = a->down[c] = c;
+        a->column[c] = c;
+        a->col_size[c] = 0;
+    }
+
+    int node = columns + 1;
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            int box = geometry->box_of[row * size + col];
+            for (int d = 0; d < size; d++) {
+                int targets[4] = {
+                    1 + row * size + col,
+                    1 + cells + row * size + d,
+                    1 + 2 * cells + col * size + d,
+                    1 + 3 * cells + box * size + d
+                };
+                int first = node;
+                for (int k = 0; k < 4; k++, node++) {
+                    int c = targets[k];
+                    a->column[node] = c;
+                    a->row_id[node] = (row * size + col) * size + d;
+                    a->left[node] = (k == 0) ? first + 3 : node - 1;
+                    a->right[node] = (k == 3) ? first : node + 1;
+                    a->up[node] = a->up[c];
+                    a->down[node] = c;
+                    a->down[a->up[c]] = node;
+                    a->up[c] = node;
+                    a->col_size[c]++;
+                }
+            }
+        }
+    }
+}
+
+// Algoritmo X: escolhe sempre a coluna com menos opções (MRV sobre células, linhas, colunas e blocos)
+static int search(DlxArena *a, int depth, int *final_depth) {
+    if (a->right[0] == 0) {
+        *final_depth = depth;
+        return 1; // Todas as restrições cobertas
+    }
+
+    int best = a->right[0];
+    for (int c = a->right[best]; c != 0; c = a->right[c]) {
+        if (a->col_size[c] < a->col_size[best]) best = c;
+    }
+    if (a->col_size[best] == 0) return 0;
+
+    cover(a, best);
+    for (int r = a->down[best]; r != best; r = a->down[r]) {
+        a->solution[depth] = a->row_id[r];
+        for (int j = a->right[r]; j != r; j = a->right[j]) cover(a, a->column[j]);
+        if (search(a, depth + 1, final_depth)) return 1;
+        for (int j = a->left[r]; j != r; j = a->left[j]) uncover(a, a->column[j]);
+    }
+    uncover(a, best);
+    return 0; // Sem solução
+}
+
+// Função para resolver o Sudoku por cobertura exata, sem alocar memória
+// A arena precisa ter sido reservada para um tamanho >= size
+int dlx_solve(DlxArena *arena, uint8_t *grid, int size) {
+    const Geometry *geometry = get_geometry(size);
+    if (size > arena->size_capacity || !geometry) return 0;
+
+    build_matrix(arena, geometry);
+
+    // Os números dados entram como opções já escolhidas
+    int columns = 4 * size * size;
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            int num = grid[row * size + col];
+            if (num == 0) continue;
+            if (num < 1 || num > size) return 0;
+
+            int first = columns + 1 + 4 * ((row * size + col) * size + num - 1);
+            int j = first;
+            do {
+                int c = arena->column[j];
+                if (arena->right[arena->left[c]] != c) return 0; // Restrição já coberta: número repetido
+                cover(arena, c);
+                j = arena->right[j];
+            } while (j != first);
+        }
+    }
+
+    int depth = 0;
+    if (!search(arena, 0, &depth)) return 0;
+
+    for (int i = 0; i < depth; i++) {
+        int option = arena->solution[i];
+        grid[option / size] = (uint8_t)(option % size + 1);
+    }
+    return 1;
+}
\ No newline at end of file
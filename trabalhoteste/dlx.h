@@ -0,0 +1,28 @@
+#ifndef DLX_H
+#define DLX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Arena dos Dancing Links: todos os nós ficam em vetores paralelos, alocados uma vez
+// e reaproveitados entre os Sudokus de um mesmo lote
+typedef struct {
+    int *left;
+    int *right;
+    int *up;
+    int *down;
+    int *column;     // coluna (restrição) de cada nó
+    int *row_id;     // opção (linha, coluna, número) de cada nó
+    int *col_size;   // quantidade de nós ainda ligados em cada coluna
+    int *solution;   // opções escolhidas na busca
+    int node_capacity;
+    int size_capacity;
+} DlxArena;
+
+void dlx_init(DlxArena *arena);
+int dlx_reserve(DlxArena *arena, int size);
+int dlx_solve(DlxArena *arena, uint8_t *grid, int size);
+size_t dlx_memory(const DlxArena *arena);
+void dlx_free(DlxArena *arena);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "geometria.h"
+#include <stdlib.h>
+
+// Uma geometria por tamanho, montada na primeira vez em que o tamanho aparece
+static Geometry *cache[MAX_GRID_SIZE + 1];
+
+// Escolhe o formato do bloco: o maior divisor de size que não passa de sua raiz vira o
+// número de linhas (9 -> 3x3, 6 -> 2x3, 8 -> 2x4, 12 -> 3x4)
+static int pick_box_rows(int size) {
+    int rows = 1;
+    for (int r = 1; r * r <= size; r++) {
+        if (size % r == 0) rows = r;
+    }
+    return rows;
+}
+
+static void free_geometry(Geometry *geometry) {
+    free(geometry->row_of);
+    free(geometry->col_of);
+    free(geometry->box_of);
+    free(geometry->peers);
+    free(geometry->units);
+    free(geometry);
+}
+
+// Monta todas as tabelas de um tamanho; retorna NULL se faltar memória
+static Geometry *build_geometry(int size, int box_rows) {
+    Geometry *g = malloc(sizeof(Geometry));
+    if (!g) return NULL;
+
+    g->size = size;
+    g->box_rows = box_rows;
+    g->box_cols = size / box_rows;
+    g->cells = size * size;
+    g->num_peers = 3 * size - g->box_rows - g->box_cols - 1;
+    g->row_of = malloc(g->cells * sizeof(int));
+    g->col_of = malloc(g->cells * sizeof(int));
+    g->box_of = malloc(g->cells * sizeof(int));
+    g->peers = malloc(g->cells * g->num_peers * sizeof(int));
+    g->units = malloc(3 * size * size * sizeof(int));
+    if (!g->row_of || !g->col_of || !g->box_of || !g->peers || !g->units) {
+        free_geometry(g);
+        return NULL;
+    }
+
+    int boxes_per_band = size / g->box_cols;
+    for (int pos = 0; pos < g->cells; pos++) {
+        int row = pos / size, col = pos % size;
+        int box = (row / g->box_rows) * boxes_per_band + col / g->box_cols;
+        int index_in_box = (row % g->box_rows) * g->box_cols + col % g->box_cols;
+        g->row_of[pos] = row;
+        g->col_of[pos] = col;
+        g->box_of[pos] = box;
+        g->units[row * size + col] = pos;
+        g->units[(size + col) * size + row] = pos;
+        g->units[(2 * size + box) * size + index_in_box] = pos;
+    }
+
+    for (int pos = 0; pos < g->cells; pos++) {
+        int n = 0;
+        for (int other = 0; other < g->cells; other++) {
+            if (other == pos) continue;
+            if (g->row_of[other] == g->row_of[pos] || g->col_of[other] == g->col_of[pos] ||
+                g->box_of[other] == g->box_of[pos]) {
+                g->peers[pos * g->num_peers + n++] = other;
+            }
+        }
+    }
+    return g;
+}
+
+// Função para obter as tabelas de um tamanho de grade
+// Retorna NULL se o tamanho não admitir blocos retangulares (ex.: números primos) ou passar de MAX_GRID_SIZE
+const Geometry *get_geometry(int size) {
+    if (size < 1 || size > MAX_GRID_SIZE) return NULL;
+    if (!cache[size]) {
+        int box_rows = pick_box_rows(size);
+        if (box_rows == 1 && size > 1) return NULL;
+        cache[size] = build_geometry(size, box_rows);
+    }
+    return cache[size];
+}
+
+// Função para liberar todas as geometrias montadas
+void free_geometries(void) {
+    for (int size = 0; size <= MAX_GRID_SIZE; size++) {
+        if (cache[size]) free_geometry(cache[size]);
+        cache[size] = NULL;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef GEOMETRIA_H
+#define GEOMETRIA_H
+
+#include <stdint.h>
+
+#define MAX_GRID_SIZE 64
+
+// Tabelas de uma grade size x size com blocos de box_rows linhas por box_cols colunas.
+// As células são numeradas por pos = row * size + col.
+typedef struct {
+    int size;
+    int box_rows;
+    int box_cols;
+    int cells;
+    int num_peers;
+    int *row_of;      // linha de cada célula
+    int *col_of;      // coluna de cada célula
+    int *box_of;      // bloco de cada célula
+    int *peers;       // vizinhos de cada célula: peers[pos * num_peers + i]
+    int *units;       // células de cada unidade: units[u * size + i]
+                      // (linhas 0..size-1, colunas size..2*size-1, blocos 2*size..3*size-1)
+} Geometry;
+
+const Geometry *get_geometry(int size);
+void free_geometries(void);
+
+// Vizinhos (mesma linha, coluna ou bloco) da célula pos
+static inline const int *geometry_peers(const Geometry *geometry, int pos) {
+    return geometry->peers + pos * geometry->num_peers;
+}
+
+#endif
\ No newline at end of file
@@ -1,4 +1,10 @@
 #include "heuristica.h"
+#include "dlx.h"
+#include "kernels.h"
+#include "geometria.h"
+#include "busca.h"
+#include "vetorial.h"
+#include "busca_paralela.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,178 +13,140 @@
 #include <sys/resource.h>
 #include <time.h>
 
-// Função para verificar se o número é válido na célula
-int is_valid(int **grid, int size, int row, int col, int num) {
-    for (int x = 0; x < size; x++) {
-        if (grid[row][x] == num || grid[x][col] == num) return 0;
-    }
-    int subgrid_rows = (int)sqrt(size);
-    int subgrid_cols = size / subgrid_rows;
+// Função de backtracking usando a heurística MRV
+// A busca iterativa roda no estado de máscaras de 64 bits; nos tamanhos com núcleo especializado
+// (4x4, 9x9, 16x16 e 25x25) a célula da MRV é escolhida pelo núcleo
+int heuristic_solve(uint8_t *grid, int size) {
+    Search search;
+    const Kernel *kernel = select_kernel(size);
+    int status = search_init(&search, grid, size, kernel ? kernel->best_cell : mask_best_cell);
+    if (status == SEARCH_RUNNING) status = search_run(&search, 0);
+    return status == SEARCH_SOLVED; // Tamanho inválido, números repetidos ou sem solução: 0
+}
 
-    if (subgrid_rows * subgrid_cols != size) {
-        fprintf(stderr, "Tamanho inválido para subgrade do Sudoku %dx%d.\n", size, size);
-        exit(EXIT_FAILURE);
-    }
+// Função de backtracking pura: a mesma busca, com as células em ordem
+int backtracking_solve(uint8_t *grid, int size) {
+    Search search;
+    int status = search_init(&search, grid, size, NULL);
+    if (status == SEARCH_RUNNING) status = search_run(&search, 0);
+    return status == SEARCH_SOLVED;
+}
 
-    int start_row = row - row % subgrid_rows;
-    int start_col = col - col % subgrid_cols;
+// Função para medir o tempo de execução e a memória usada
+// memory é a memória da grade e do estado do resolvedor; o pico vem do getrusage
+void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end, size_t memory) {
+    long seconds = end->tv_sec - start->tv_sec;
+    long microseconds = end->tv_usec - start->tv_usec;
+    double real_time = seconds + microseconds * 1e-6;
 
-    for (int i = 0; i < subgrid_rows; i++) {
-        for (int j = 0; j < subgrid_cols; j++) {
-            if (grid[start_row + i][start_col + j] == num) return 0;
-        }
-    }
-    return 1;
+    double cpu_time = ((double)(cpu_end - cpu_start)) / CLOCKS_PER_SEC;
+
+    printf("Tempo de execução (tempo real): %.6f segundos\n", real_time);
+    printf("Tempo de execução (tempo de CPU): %.6f segundos\n", cpu_time);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("Memória do resolvedor: %zu bytes (pico do processo: %ld KB)\n", memory, usage.ru_maxrss);
 }
 
-// Função para calcular o número de possibilidades para uma célula
-int count_possibilities(int **grid, int size, int row, int col) {
-    int count = 0;
-    for (int num = 1; num <= size; num++) {
-        if (is_valid(grid, size, row, col, num)) count++;
+// Função para mostrar a curva de aceleração da busca paralela (opção -e)
+// Resolve cópias da grade com 1, 2, 4, ... até max_threads threads e compara com 1 thread
+static void print_speedup_curve(const uint8_t *grid, int size, int max_threads) {
+    int cells = size * size;
+    uint8_t *copy = malloc(cells);
+    if (!copy) {
+        perror("Erro ao alocar a cópia da grade");
+        exit(EXIT_FAILURE);
     }
-    return count;
-}
 
-// Função para encontrar a célula com menos possibilidades (heurística MRV)
-Cell find_best_cell(int **grid, int size) {
-    Cell best_cell = {-1, -1, size + 1};
-    for (int row = 0; row < size; row++) {
-        for (int col = 0; col < size; col++) {
-            if (grid[row][col] == 0) {
-                int possibilities = count_possibilities(grid, size, row, col);
-                if (possibilities < best_cell.possibilities) {
-                    best_cell.row = row;
-                    best_cell.col = col;
-                    best_cell.possibilities = possibilities;
-                }
-            }
-        }
+    double base = 0;
+    for (int t = 1; t <= max_threads; t = (t < max_threads && 2 * t > max_threads) ? max_threads : 2 * t) {
+        ParallelStats stats;
+        struct timeval start, end;
+        memcpy(copy, grid, cells);
+        gettimeofday(&start, NULL);
+        parallel_solve(copy, size, t, &stats);
+        gettimeofday(&end, NULL);
+
+        double seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) * 1e-6;
+        if (t == 1) base = seconds;
+        printf("  %3d threads: %.6f segundos, aceleração %.2fx, tentativas: %ld, roubos: %ld\n", t, seconds,
+               seconds > 0 ? base / seconds : 0.0, stats.nodes, stats.steals);
     }
-    return best_cell;
+    free(copy);
 }
 
-// Função de backtracking usando a heurística MRV
-int heuristic_solve(int **grid, int size) {
-    Cell cell = find_best_cell(grid, size);
-    if (cell.row == -1) return 1; // Sudoku resolvido
-
-    for (int num = 1; num <= size; num++) {
-        if (is_valid(grid, size, cell.row, cell.col, num)) {
-            grid[cell.row][cell.col] = num;
-            if (heuristic_solve(grid, size)) return 1;
-            grid[cell.row][cell.col] = 0;
+// Função principal
+int main(int argc, char *argv[]) {
+    int method = 1; // 0 = backtracking simples, 1 = heurística MRV, 2 = Dancing Links
+    int threads = 0; // threads da busca MRV paralela (0 = busca sequencial)
+    int speedup_curve = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:j:e")) != -1) {
+        switch (opt) {
+            case 'm':
+                method = atoi(optarg);
+                break;
+            case 'j':
+                threads = atoi(optarg);
+                break;
+            case 'e':
+                speedup_curve = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-m <0=simples, 1=heurística, 2=dlx>] [-j <threads> [-e]] <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+                exit(EXIT_FAILURE);
         }
     }
-    return 0; // Sem solução
-}
 
-// Função para carregar múltiplos Sudokus do arquivo
-int load_multiple_sudokus(const char *filename, int ****puzzles, int **sizes, int *puzzle_count) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        perror("Erro ao abrir arquivo de entrada");
+    // A busca paralela (-j) e a curva de aceleração (-e) só existem para a heurística
+    if (argc - optind != 2 || method < 0 || method > 2 || threads < 0 || threads > MAX_THREADS ||
+        (threads > 0 && method != 1) || (speedup_curve && threads == 0)) {
+        fprintf(stderr, "Uso: %s [-m <0=simples, 1=heurística, 2=dlx>] [-j <threads> [-e]] <arquivo_entrada> <arquivo_saida>\n", argv[0]);
         exit(EXIT_FAILURE);
     }
-    *puzzle_count = 0;
-    *puzzles = NULL;
-    *sizes = NULL;
-
-    char line[256];
-    while (fgets(line, sizeof(line), file)) {
-        if (line[0] == '#' || line[0] == '\n') continue; // Ignora comentários e linhas vazias
-
-        // Determina o tamanho da grade com base na contagem de números na linha
-        int size = 0;
-        for (int i = 0; line[i] != '\0'; i++) {
-            if (line[i] != ' ' && line[i] != '\n') size++;
-        }
-
-        *puzzles = realloc(*puzzles, (*puzzle_count + 1) * sizeof(int **));
-        *sizes = realloc(*sizes, (*puzzle_count + 1) * sizeof(int));
-        (*sizes)[*puzzle_count] = size;
 
-        // Aloca memória para a grade
-        (*puzzles)[*puzzle_count] = malloc(size * sizeof(int *));
-        for (int i = 0; i < size; i++) {
-            (*puzzles)[*puzzle_count][i] = malloc(size * sizeof(int));
-        }
+    char *input_file = argv[optind];
+    char *output_file = argv[optind + 1];
+    const char *method_names[] = {"backtracking", "heurística", "dancing links"};
 
-        // Preenche a grade
-        for (int row = 0; row < size; row++) {
-            for (int col = 0, idx = 0; col < size; col++, idx += 2) {
-                (*puzzles)[*puzzle_count][row][col] = (line[idx] == EMPTY) ? 0 : line[idx] - '0';
-            }
-            fgets(line, sizeof(line), file);
-        }
+    PuzzleBatch batch;
 
-        (*puzzle_count)++;
-    }
+    // Carrega múltiplos Sudokus (todas as grades em uma única arena)
+    load_multiple_sudokus(input_file, &batch);
+    int puzzle_count = batch.count;
+    int *sizes = batch.sizes;
 
-    fclose(file);
-    return *puzzle_count;
-}
-
-// Função para salvar múltiplos Sudokus no arquivo
-void save_multiple_sudokus(const char *filename, int ***puzzles, int *sizes, int puzzle_count) {
-    FILE *file = fopen(filename, "w");
-    if (!file) {
-        perror("Erro ao abrir arquivo de saída");
-        exit(EXIT_FAILURE);
-    }
-
-    for (int p = 0; p < puzzle_count; p++) {
-        int size = sizes[p];
-        for (int i = 0; i < size; i++) {
-            for (int j = 0; j < size; j++) {
-                if (puzzles[p][i][j] == 0) {
-                    fprintf(file, "%c ", EMPTY);
-                } else {
-                    fprintf(file, "%d ", puzzles[p][i][j]);
-                }
-            }
-            fprintf(file, "\n");
+    // A arena do DLX é alocada uma única vez, para o maior Sudoku do lote
+    DlxArena arena;
+    dlx_init(&arena);
+    if (method == 2) {
+        int max_size = 0;
+        for (int p = 0; p < puzzle_count; p++) {
+            if (sizes[p] > max_size) max_size = sizes[p];
         }
-        if (p < puzzle_count - 1) {
-            fprintf(file, "\n");
+        if (!dlx_reserve(&arena, max_size)) {
+            fprintf(stderr, "Memória insuficiente para o Dancing Links %dx%d.\n", max_size, max_size);
+            exit(EXIT_FAILURE);
         }
     }
 
-    fclose(file);
-}
-
-// Função para medir o tempo de execução
-void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end) {
-    long seconds = end->tv_sec - start->tv_sec;
-    long microseconds = end->tv_usec - start->tv_usec;
-    double real_time = seconds + microseconds * 1e-6;
-
-    double cpu_time = ((double)(cpu_end - cpu_start)) / CLOCKS_PER_SEC;
-
-    printf("Tempo de execução (tempo real): %.6f segundos\n", real_time);
-    printf("Tempo de execução (tempo de CPU): %.6f segundos\n", cpu_time);
-}
-
-// Função principal
-int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida>\n", argv[0]);
-        exit(EXIT_FAILURE);
+    // Os núcleos 9x9 e 16x16 da heurística usam a varredura vetorial, se o processador tiver AVX2
+    if (method == 1 && threads == 0) {
+        printf("Candidatos da MRV calculados com a versão %s.\n", mrv_scan_backend());
     }
 
-    char *input_file = argv[1];
-    char *output_file = argv[2];
-
-    int ***puzzles;
-    int *sizes;
-    int puzzle_count;
-    struct timeval start, end;
+    for (int p = 0; p < puzzle_count; p++) {
+        printf("Resolvendo Sudoku #%d de tamanho %dx%d com %s...\n", p + 1, sizes[p], sizes[p], method_names[method]);
 
-    // Carrega múltiplos Sudokus
-    load_multiple_sudokus(input_file, &puzzles, &sizes, &puzzle_count);
+        // Tamanhos sem blocos retangulares (ex.: primos) são pulados em vez de encerrar o programa
+        if (!get_geometry(sizes[p])) {
+            fprintf(stderr, "Tamanho inválido para subgrade do Sudoku %dx%d.\n", sizes[p], sizes[p]);
+            continue;
+        }
 
-    for (int p = 0; p < puzzle_count; p++) {
-        printf("Resolvendo Sudoku #%d de tamanho %dx%d com heurística...\n", p + 1, sizes[p], sizes[p]);
+        if (speedup_curve) print_speedup_curve(batch.grids[p], sizes[p], threads);
 
         // Medir tempo de resolução
         struct timeval start, end;
@@ -187,7 +155,17 @@ int main(int argc, char *argv[]) {
         gettimeofday(&start, NULL);
         cpu_start = clock();
 
-        int solved = heuristic_solve(puzzles[p], sizes[p]);
+        int solved;
+        ParallelStats parallel_stats;
+        if (method == 0) {
+            solved = backtracking_solve(batch.grids[p], sizes[p]);
+        } else if (method == 2) {
+            solved = dlx_solve(&arena, batch.grids[p], sizes[p]);
+        } else if (threads > 0) {
+            solved = parallel_solve(batch.grids[p], sizes[p], threads, &parallel_stats);
+        } else {
+            solved = heuristic_solve(batch.grids[p], sizes[p]);
+        }
 
         cpu_end = clock();
         gettimeofday(&end, NULL);
@@ -195,21 +173,29 @@ int main(int argc, char *argv[]) {
         if (!solved) {
             fprintf(stderr, "Sem solução para o Sudoku #%d.\n", p + 1);
         } else {
-            measure_time(&start, &end, cpu_start, cpu_end);
+            // Memória da resolução: a grade contígua mais o estado do resolvedor escolhido
+            size_t memory = (size_t)sizes[p] * sizes[p];
+            if (method == 2) {
+                memory += dlx_memory(&arena);
+            } else if (threads > 0) {
+                memory += threads * (sizeof(Search) + memory); // Busca e grade de trabalho de cada thread
+            } else {
+                memory += sizeof(Search);
+            }
+            measure_time(&start, &end, cpu_start, cpu_end, memory);
+            if (threads > 0) {
+                printf("Busca paralela com %d threads: %ld tentativas, %ld tarefas, %ld roubadas\n", threads,
+                       parallel_stats.nodes, parallel_stats.tasks, parallel_stats.steals);
+            }
         }
     }
 
-    save_multiple_sudokus(output_file, puzzles, sizes, puzzle_count);
+    save_multiple_sudokus(output_file, &batch);
 
     // Libera memória
-    for (int p = 0; p < puzzle_count; p++) {
-        for (int i = 0; i < sizes[p]; i++) {
-            free(puzzles[p][i]);
-        }
-        free(puzzles[p]);
-    }
-    free(puzzles);
-    free(sizes);
+    dlx_free(&arena);
+    free_puzzles(&batch);
+    free_geometries();
 
     printf("Todos os Sudokus resolvidos e salvos em '%s'.\n", output_file);
 
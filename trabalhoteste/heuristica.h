@@ -4,22 +4,11 @@
 #include <sys/time.h>
 #include <math.h>
 #include <time.h>
+#include <stddef.h>
+#include "lote.h"
 
-#define EMPTY 'v'
-
-typedef struct {
-    int row;
-    int col;
-    int possibilities;
-} Cell;
-
-int is_valid(int **grid, int size, int row, int col, int num);
-int count_possibilities(int **grid, int size, int row, int col);
-Cell find_best_cell(int **grid, int size);
-int heuristic_solve(int **grid, int size);
-int backtracking_solve(int **grid, int size);
-int load_multiple_sudokus(const char *filename, int ****puzzles, int **sizes, int *puzzle_count);
-void save_multiple_sudokus(const char *filename, int ***puzzles, int *sizes, int puzzle_count);
-void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end); // Corrigido
+int heuristic_solve(uint8_t *grid, int size);
+int backtracking_solve(uint8_t *grid, int size);
+void measure_time(struct timeval *start, struct timeval *end, clock_t cpu_start, clock_t cpu_end, size_t memory); // Corrigido
 
 #endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+// Escolha da célula da MRV especializada para uma ordem de bloco fixa.
+// Este arquivo não tem include guard: kernels.c o inclui uma vez para cada
+// valor de BOX, e todos os laços passam a ter limites constantes (sem sqrt nem divisões por size).
+
+#ifndef BOX
+#error "Defina BOX antes de incluir kernel_template.h"
+#endif
+
+#define N (BOX * BOX)
+
+#if BOX == 3 || BOX == 4
+// Função para escolher a célula vazia com menos candidatos (heurística MRV)
+// Os candidatos da grade inteira saem de uma varredura vetorial (mrv_scan)
+static int KERNEL_NAME(best_cell)(const MaskState *state, Mask *candidates) {
+    MrvChoice choice = mrv_scan(state->grid, BOX);
+    *candidates = choice.candidates;
+    return choice.pos;
+}
+#else
+// Função para escolher a célula vazia com menos candidatos (heurística MRV)
+// Os candidatos saem das máscaras do estado; linha, coluna e bloco vêm de divisões por constantes
+static int KERNEL_NAME(best_cell)(const MaskState *state, Mask *candidates) {
+    int best = -1, best_count = N + 1;
+    for (int row = 0; row < N; row++) {
+        const uint8_t *line = state->grid + row * N;
+        Mask row_used = state->rows[row];
+        const Mask *boxes = state->boxes + (row / BOX) * BOX;
+        for (int col = 0; col < N; col++) {
+            if (line[col] != 0) continue;
+            Mask cell = state->all_digits & ~(row_used | state->cols[col] | boxes[col / BOX]);
+            int count = count_bits(cell);
+            if (count < best_count) {
+                best = row * N + col;
+                best_count = count;
+                *candidates = cell;
+                if (count <= 1) return best; // Não há escolha melhor
+            }
+        }
+    }
+    return best;
+}
+#endif
+
+#undef N
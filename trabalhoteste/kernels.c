@@ -0,0 +1,40 @@
+#include "kernels.h"
+#include "vetorial.h"
+#include <stddef.h>
+
+#define KERNEL_PASTE2(name, box) name##_##box
+#define KERNEL_PASTE(name, box) KERNEL_PASTE2(name, box)
+#define KERNEL_NAME(name) KERNEL_PASTE(name, BOX)
+
+// Uma instância do núcleo para cada ordem de bloco suportada: 4x4, 9x9, 16x16 e 25x25
+#define BOX 2
+#include "kernel_template.h"
+#undef BOX
+
+#define BOX 3
+#include "kernel_template.h"
+#undef BOX
+
+#define BOX 4
+#include "kernel_template.h"
+#undef BOX
+
+#define BOX 5
+#include "kernel_template.h"
+#undef BOX
+
+static const Kernel kernels[] = {
+    {4, best_cell_2},
+    {9, best_cell_3},
+    {16, best_cell_4},
+    {25, best_cell_5},
+};
+
+// Função para escolher o núcleo especializado do tamanho dado
+// Retorna NULL se o tamanho não tiver especialização (usa-se mask_best_cell)
+const Kernel *select_kernel(int size) {
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        if (kernels[i].size == size) return &kernels[i];
+    }
+    return NULL;
+}
\ No newline at end of file
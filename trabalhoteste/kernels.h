@@ -0,0 +1,14 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "mascaras.h"
+
+// Escolha da MRV especializada para um tamanho de grade conhecido em tempo de compilação
+typedef struct {
+    int size;
+    CellChooser best_cell;
+} Kernel;
+
+const Kernel *select_kernel(int size);
+
+#endif
\ No newline at end of file
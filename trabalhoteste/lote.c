@@ -0,0 +1,245 @@
+#include "lote.h"
+#include "geometria.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Na arena, cada Sudoku é gravado como um registro: 1 byte com o tamanho seguido das
+// size * size células. Depois da leitura, o índice é acrescentado ao fim da arena.
+
+// Função para garantir espaço para mais extra bytes na arena, dobrando a capacidade
+static void reserve_arena(unsigned char **arena, size_t *capacity, size_t used, size_t extra) {
+    if (used + extra <= *capacity) return;
+
+    size_t new_capacity = *capacity ? *capacity : 4096;
+    while (new_capacity < used + extra) new_capacity *= 2;
+
+    unsigned char *grown = realloc(*arena, new_capacity);
+    if (!grown) {
+        perror("Erro ao alocar memória para os Sudokus");
+        exit(EXIT_FAILURE);
+    }
+    *arena = grown;
+    *capacity = new_capacity;
+}
+
+// Função para converter um símbolo da entrada em número
+// 'v', '.' e '0' são células vazias; números decimais valem o próprio valor (10, 11, ..., 64)
+// e letras maiúsculas isoladas seguem a convenção A = 10, B = 11, ..., Z = 35.
+// Retorna -1 se o símbolo não for reconhecido.
+static int decode_symbol(const char *token, size_t length) {
+    if (length == 1) {
+        char ch = token[0];
+        if (ch == EMPTY || ch == '.') return 0;
+        if (ch >= '0' && ch <= '9') return ch - '0';
+        if (ch >= 'A' && ch <= 'Z') return ch - 'A' + 10;
+        return -1;
+    }
+
+    int value = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (token[i] < '0' || token[i] > '9' || value > MAX_GRID_SIZE) return -1;
+        value = value * 10 + (token[i] - '0');
+    }
+    return value;
+}
+
+// Função para separar o próximo símbolo da linha a partir de *cursor
+// Retorna o tamanho do símbolo (0 no fim da linha) e guarda seu início em *token
+static size_t next_token(const char **cursor, const char **token) {
+    const char *p = *cursor;
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    *token = p;
+    while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+    *cursor = p;
+    return (size_t)(p - *token);
+}
+
+// Função para contar os símbolos de uma linha
+static int count_tokens(const char *line) {
+    const char *token;
+    int count = 0;
+    while (next_token(&line, &token) > 0) count++;
+    return count;
+}
+
+// Função para carregar múltiplos Sudokus do arquivo
+// As linhas podem ter qualquer comprimento e os símbolos, mais de um caractere
+int load_multiple_sudokus(const char *filename, PuzzleBatch *batch) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Erro ao abrir arquivo de entrada");
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned char *arena = NULL;
+    size_t capacity = 0, used = 0;
+    int count = 0;
+
+    char *line = NULL;
+    size_t line_capacity = 0;
+    long line_number = 0;
+    while (getline(&line, &line_capacity, file) != -1) {
+        line_number++;
+        if (line[0] == '#') continue; // Ignora comentários
+
+        // O tamanho da grade é a quantidade de símbolos na primeira linha
+        int size = count_tokens(line);
+        if (size == 0) continue; // Ignora linhas vazias
+
+        // Grades maiores que MAX_GRID_SIZE não cabem nas máscaras: as linhas são descartadas
+        if (size > MAX_GRID_SIZE) {
+            fprintf(stderr, "Sudoku %dx%d maior que o limite de %dx%d; ignorado.\n", size, size, MAX_GRID_SIZE, MAX_GRID_SIZE);
+            for (int row = 1; row < size && getline(&line, &line_capacity, file) != -1; row++) line_number++;
+            continue;
+        }
+
+        reserve_arena(&arena, &capacity, used, 1 + (size_t)size * size);
+        arena[used] = (unsigned char)size;
+        uint8_t *grid = arena + used + 1;
+
+        // Preenche a grade, uma linha do arquivo por linha da grade
+        // Se o arquivo terminar antes, as linhas que faltam ficam vazias
+        for (int row = 0; row < size; row++) {
+            if (row > 0) {
+                if (getline(&line, &line_capacity, file) == -1) {
+                    fprintf(stderr, "Sudoku %dx%d incompleto no fim do arquivo (linha %ld).\n", size, size, line_number);
+                    for (int pos = row * size; pos < size * size; pos++) grid[pos] = 0;
+                    break;
+                }
+                line_number++;
+            }
+
+            const char *cursor = line, *token;
+            for (int col = 0; col < size; col++) {
+                size_t length = next_token(&cursor, &token);
+                int num = decode_symbol(token, length);
+                if (length == 0) {
+                    fprintf(stderr, "Linha %ld: esperados %d símbolos.\n", line_number, size);
+                    exit(EXIT_FAILURE);
+                }
+                if (num < 0 || num > size) {
+                    fprintf(stderr, "Linha %ld: símbolo inválido '%.*s' para um Sudoku %dx%d.\n",
+                            line_number, (int)length, token, size, size);
+                    exit(EXIT_FAILURE);
+                }
+                grid[row * size + col] = (uint8_t)num;
+            }
+            if (next_token(&cursor, &token) > 0) {
+                fprintf(stderr, "Linha %ld: esperados %d símbolos.\n", line_number, size);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        used += 1 + (size_t)size * size;
+        count++;
+    }
+    free(line);
+    fclose(file);
+
+    // Acrescenta o índice ao fim da arena, alinhado para os ponteiros
+    size_t index_offset = (used + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    size_t total = index_offset + count * (sizeof(uint8_t *) + sizeof(int));
+    unsigned char *final_arena = realloc(arena, total ? total : 1);
+    if (!final_arena) {
+        perror("Erro ao alocar memória para os Sudokus");
+        exit(EXIT_FAILURE);
+    }
+
+    batch->arena = final_arena;
+    batch->grids = (uint8_t **)(final_arena + index_offset);
+    batch->sizes = (int *)(batch->grids + count);
+    batch->count = count;
+
+    size_t offset = 0;
+    for (int p = 0; p < count; p++) {
+        int size = final_arena[offset];
+        batch->sizes[p] = size;
+        batch->grids[p] = final_arena + offset + 1;
+        offset += 1 + (size_t)size * size;
+    }
+    return count;
+}
+
+// Tamanho do bloco de saída, escrito com um único write()
+#define OUTPUT_BUFFER (1 << 20)
+// Maior texto de uma linha: até 4 bytes por célula ("255 ") e a quebra de linha
+#define ROW_TEXT_MAX(size) ((size_t)(size) * 4 + 2)
+
+// Escreve o bloco acumulado no descritor, repetindo enquanto a escrita for parcial
+static void flush_output(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("Erro ao escrever arquivo de saída");
+            exit(EXIT_FAILURE);
+        }
+        data += n;
+        length -= n;
+    }
+}
+
+// Função para salvar múltiplos Sudokus no arquivo
+// O texto é montado em um bloco com uma tabela do texto de cada valor (o mesmo de um
+// fprintf("%d ") por célula) e o bloco vai para o arquivo quando enche
+void save_multiple_sudokus(const char *filename, const PuzzleBatch *batch) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        perror("Erro ao abrir arquivo de saída");
+        exit(EXIT_FAILURE);
+    }
+    char *buffer = malloc(OUTPUT_BUFFER);
+    if (!buffer) {
+        perror("Erro ao alocar o buffer de saída");
+        exit(EXIT_FAILURE);
+    }
+
+    char cell_text[256][4];
+    unsigned char cell_length[256];
+    cell_text[0][0] = EMPTY;
+    cell_text[0][1] = ' ';
+    cell_length[0] = 2;
+    for (int value = 1; value < 256; value++) {
+        char digits[8];
+        cell_length[value] = (unsigned char)sprintf(digits, "%d ", value);
+        memcpy(cell_text[value], digits, cell_length[value]);
+    }
+
+    int fd = fileno(file);
+    size_t used = 0;
+    for (int p = 0; p < batch->count; p++) {
+        int size = batch->sizes[p];
+        const uint8_t *grid = batch->grids[p];
+        for (int i = 0; i < size; i++) {
+            if (OUTPUT_BUFFER - used < ROW_TEXT_MAX(size)) {
+                flush_output(fd, buffer, used);
+                used = 0;
+            }
+            char *out = buffer + used;
+            for (int j = 0; j < size; j++) {
+                uint8_t value = grid[i * size + j];
+                memcpy(out, cell_text[value], 4);
+                out += cell_length[value];
+            }
+            *out++ = '\n';
+            if (i == size - 1 && p < batch->count - 1) *out++ = '\n';
+            used = out - buffer;
+        }
+    }
+    flush_output(fd, buffer, used);
+
+    free(buffer);
+    fclose(file);
+}
+
+// Função para liberar o lote inteiro (grades e índice) de uma vez
+void free_puzzles(PuzzleBatch *batch) {
+    free(batch->arena);
+    batch->arena = NULL;
+    batch->grids = NULL;
+    batch->sizes = NULL;
+    batch->count = 0;
+}
@@ -0,0 +1,23 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stdint.h>
+
+#define EMPTY 'v'
+
+// Lote de Sudokus lido de um arquivo. Todas as grades ficam em um único bloco (arena):
+// cada grade é um vetor contíguo de size * size bytes, acessado por grid[row * size + col],
+// com 0 nas células vazias. O índice (grids e sizes) fica no fim do mesmo bloco,
+// então o lote inteiro é liberado com uma única chamada a free_puzzles.
+typedef struct {
+    unsigned char *arena;
+    uint8_t **grids;   // início de cada grade dentro da arena
+    int *sizes;        // tamanho (lado) de cada grade
+    int count;
+} PuzzleBatch;
+
+int load_multiple_sudokus(const char *filename, PuzzleBatch *batch);
+void save_multiple_sudokus(const char *filename, const PuzzleBatch *batch);
+void free_puzzles(PuzzleBatch *batch);
+
+#endif
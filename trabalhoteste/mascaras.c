@@ -0,0 +1,43 @@
+#include "mascaras.h"
+
+// Função para montar o estado a partir da grade
+// Retorna 0 se o tamanho não tiver geometria, se algum número estiver fora de 1..size
+// ou se os números dados se repetirem em uma linha, coluna ou bloco
+int mask_state_init(MaskState *state, uint8_t *grid, int size) {
+    const Geometry *g = get_geometry(size);
+    if (!g) return 0;
+
+    state->geometry = g;
+    state->grid = grid;
+    state->all_digits = (size == 64) ? ~(Mask)0 : DIGIT_BIT(size + 1) - 1;
+    for (int i = 0; i < size; i++) {
+        state->rows[i] = state->cols[i] = state->boxes[i] = 0;
+    }
+
+    for (int pos = 0; pos < g->cells; pos++) {
+        int num = grid[pos];
+        if (num == 0) continue;
+        if (num > size || !(mask_candidates(state, pos) & DIGIT_BIT(num))) return 0;
+        mask_place(state, pos, num);
+    }
+    return 1;
+}
+
+// Função para escolher a célula vazia com menos candidatos (heurística MRV)
+// Retorna -1 se não houver célula vazia; os candidatos da célula escolhida vão para *candidates
+int mask_best_cell(const MaskState *state, Mask *candidates) {
+    const Geometry *g = state->geometry;
+    int best = -1, best_count = g->size + 1;
+    for (int pos = 0; pos < g->cells; pos++) {
+        if (state->grid[pos] != 0) continue;
+        Mask cell = mask_candidates(state, pos);
+        int count = count_bits(cell);
+        if (count < best_count) {
+            best = pos;
+            best_count = count;
+            *candidates = cell;
+            if (count <= 1) break; // Não há escolha melhor
+        }
+    }
+    return best;
+}
@@ -0,0 +1,68 @@
+#ifndef MASCARAS_H
+#define MASCARAS_H
+
+#include <stdint.h>
+#include "geometria.h"
+
+// Máscara de números: o bit (num - 1) representa o número num (até 64x64)
+typedef uint64_t Mask;
+
+#define DIGIT_BIT(num) ((Mask)1 << ((num) - 1))
+
+// Estado do resolvedor genérico: a grade contígua e os números já usados em cada
+// linha, coluna e bloco. Ocupa 3 * 64 máscaras de 8 bytes, qualquer que seja o tamanho.
+typedef struct {
+    const Geometry *geometry;
+    uint8_t *grid;
+    Mask all_digits;
+    Mask rows[MAX_GRID_SIZE];
+    Mask cols[MAX_GRID_SIZE];
+    Mask boxes[MAX_GRID_SIZE];
+} MaskState;
+
+// Função que escolhe a próxima célula da MRV: retorna a posição (-1 se a grade estiver completa)
+// e os candidatos dela em *candidates. mask_best_cell serve a qualquer tamanho; kernels.h tem
+// versões especializadas
+typedef int (*CellChooser)(const MaskState *state, Mask *candidates);
+
+int mask_state_init(MaskState *state, uint8_t *grid, int size);
+int mask_best_cell(const MaskState *state, Mask *candidates);
+
+// Número de bits ligados na máscara
+static inline int count_bits(Mask mask) {
+    return __builtin_popcountll(mask);
+}
+
+// Número representado pelo bit menos significativo da máscara
+static inline int lowest_digit(Mask mask) {
+    return __builtin_ctzll(mask) + 1;
+}
+
+// Números ainda possíveis para a célula pos
+static inline Mask mask_candidates(const MaskState *state, int pos) {
+    const Geometry *g = state->geometry;
+    return state->all_digits & ~(state->rows[g->row_of[pos]] | state->cols[g->col_of[pos]] |
+                                 state->boxes[g->box_of[pos]]);
+}
+
+// Coloca o número na célula e marca-o na linha, coluna e bloco
+static inline void mask_place(MaskState *state, int pos, int num) {
+    const Geometry *g = state->geometry;
+    Mask bit = DIGIT_BIT(num);
+    state->grid[pos] = (uint8_t)num;
+    state->rows[g->row_of[pos]] |= bit;
+    state->cols[g->col_of[pos]] |= bit;
+    state->boxes[g->box_of[pos]] |= bit;
+}
+
+// Desfaz a jogada da célula, liberando o número na linha, coluna e bloco
+static inline void mask_undo(MaskState *state, int pos) {
+    const Geometry *g = state->geometry;
+    Mask bit = ~DIGIT_BIT(state->grid[pos]);
+    state->grid[pos] = 0;
+    state->rows[g->row_of[pos]] &= bit;
+    state->cols[g->col_of[pos]] &= bit;
+    state->boxes[g->box_of[pos]] &= bit;
+}
+
+#endif
@@ -0,0 +1,200 @@
+#include "vetorial.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+// Versão escalar: máscaras de linhas, colunas e blocos em uma passada e a MRV em outra
+static MrvChoice scan_scalar(const uint8_t *grid, int box) {
+    int size = box * box;
+    uint16_t rows[16] = {0}, cols[16] = {0}, boxes[16] = {0};
+
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            int num = grid[row * size + col];
+            if (num == 0) continue;
+            uint16_t bit = (uint16_t)(1u << (num - 1));
+            rows[row] |= bit;
+            cols[col] |= bit;
+            boxes[(row / box) * box + col / box] |= bit;
+        }
+    }
+
+    uint16_t all_digits = (uint16_t)((1u << size) - 1);
+    MrvChoice best = {-1, size + 1, 0};
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            int pos = row * size + col;
+            if (grid[pos] != 0) continue;
+            uint16_t candidates = all_digits & ~(rows[row] | cols[col] | boxes[(row / box) * box + col / box]);
+            int count = __builtin_popcount(candidates);
+            if (count < best.count) {
+                best.pos = pos;
+                best.count = count;
+                best.candidates = candidates;
+                if (count == 0) return best; // Contradição: não há escolha melhor
+            }
+        }
+    }
+    return best;
+}
+
+#ifdef HAVE_AVX2_KERNEL
+
+// Cada linha da grade ocupa um vetor de 16 palavras de 16 bits (slots), 4 slots por bloco:
+// a coluna col vai para o slot (col / box) * 4 + col % box. Assim os blocos ficam sempre
+// alinhados em grupos de 4 palavras, tanto no 9x9 (3 slots usados por grupo) quanto no 16x16.
+
+// Tabelas dos slots para box = 3 e box = 4: índices do pshufb que levam os bytes da linha
+// para os slots (0x80 zera o slot), slots usados e coluna de cada slot
+typedef struct {
+    uint8_t bytes[16];
+    uint16_t valid[16];
+    uint16_t columns[16];
+} SlotLayout;
+
+static const SlotLayout layouts[2] = {
+    {{0, 1, 2, 0x80, 3, 4, 5, 0x80, 6, 7, 8, 0x80, 0x80, 0x80, 0x80, 0x80},
+     {0xFFFF, 0xFFFF, 0xFFFF, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0, 0, 0, 0, 0},
+     {0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 0, 0, 0, 0}},
+    {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+     {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+      0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF},
+     {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}},
+};
+
+// OR de todas as 16 palavras, repetido em todas elas
+__attribute__((target("avx2")))
+static inline __m256i or_all_words(__m256i x) {
+    x = _mm256_or_si256(x, _mm256_permute2x128_si256(x, x, 1));
+    x = _mm256_or_si256(x, _mm256_shuffle_epi32(x, 0x4E));
+    x = _mm256_or_si256(x, _mm256_shuffle_epi32(x, 0xB1));
+    return _mm256_or_si256(x, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xB1), 0xB1));
+}
+
+// OR de cada grupo de 4 palavras (um bloco), repetido nas palavras do grupo
+__attribute__((target("avx2")))
+static inline __m256i or_groups_of_4(__m256i x) {
+    x = _mm256_or_si256(x, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xB1), 0xB1));
+    return _mm256_or_si256(x, _mm256_shuffle_epi32(x, 0xB1));
+}
+
+// Versão AVX2: bits dos números, máscaras de linha, coluna e bloco, candidatos, contagens
+// e a redução do mínimo são todos feitos com vetores de 16 palavras
+__attribute__((target("avx2"), always_inline))
+static inline MrvChoice scan_avx2_box(const uint8_t *grid, int box) {
+    int size = box * box;
+
+    const SlotLayout *slots = &layouts[box - 3];
+    __m128i layout = _mm_loadu_si128((const __m128i *)slots->bytes);
+    __m256i valid = _mm256_loadu_si256((const __m256i *)slots->valid);
+    __m256i column_positions = _mm256_loadu_si256((const __m256i *)slots->columns);
+
+    // Número num (1..16) vira o bit num - 1, em duas metades de 8 bits
+    const __m128i bit_low = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i bit_high = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i one = _mm_set1_epi8(1);
+
+    __m256i bits[16], empty[16];
+    __m256i cols = _mm256_setzero_si256();
+    for (int row = 0; row < size; row++) {
+        // No 9x9 a última linha é lida terminando no fim da grade e deslocada,
+        // para não ler além dos 81 bytes
+        __m128i raw;
+        if (size == 9 && row == 8) {
+            raw = _mm_srli_si128(_mm_loadu_si128((const __m128i *)(grid + 81 - 16)), 16 - 9);
+        } else {
+            raw = _mm_loadu_si128((const __m128i *)(grid + row * size));
+        }
+        __m128i values = _mm_shuffle_epi8(raw, layout);
+        __m128i index = _mm_sub_epi8(values, one); // Vazio (0) vira 0xFF, que o pshufb zera
+        __m256i low = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(bit_low, index));
+        __m256i high = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(bit_high, index));
+        bits[row] = _mm256_or_si256(low, _mm256_slli_epi16(high, 8));
+        empty[row] = _mm256_and_si256(valid, _mm256_cmpeq_epi16(_mm256_cvtepu8_epi16(values), _mm256_setzero_si256()));
+        cols = _mm256_or_si256(cols, bits[row]);
+    }
+
+    const __m256i all_digits = _mm256_set1_epi16((short)((1u << size) - 1));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i popcount_table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i ones = _mm256_set1_epi8(1);
+
+    // Chave de cada célula: (contagem << 8) | posição; células preenchidas valem 0xFFFF
+    uint16_t candidates[16][16];
+    __m256i best = _mm256_set1_epi16(-1);
+    for (int band = 0; band < box; band++) {
+        __m256i band_bits = _mm256_setzero_si256();
+        for (int i = 0; i < box; i++) band_bits = _mm256_or_si256(band_bits, bits[band * box + i]);
+        __m256i boxes = or_groups_of_4(band_bits);
+
+        for (int i = 0; i < box; i++) {
+            int row = band * box + i;
+            __m256i used = _mm256_or_si256(_mm256_or_si256(or_all_words(bits[row]), cols), boxes);
+            __m256i cand = _mm256_and_si256(_mm256_andnot_si256(used, all_digits), empty[row]);
+            _mm256_storeu_si256((__m256i *)candidates[row], cand);
+
+            __m256i low = _mm256_shuffle_epi8(popcount_table, _mm256_and_si256(cand, nibble));
+            __m256i high = _mm256_shuffle_epi8(popcount_table, _mm256_and_si256(_mm256_srli_epi16(cand, 4), nibble));
+            __m256i count = _mm256_maddubs_epi16(_mm256_add_epi8(low, high), ones);
+
+            __m256i pos = _mm256_add_epi16(column_positions, _mm256_set1_epi16((short)(row * size)));
+            __m256i key = _mm256_or_si256(_mm256_slli_epi16(count, 8), pos);
+            key = _mm256_or_si256(_mm256_and_si256(empty[row], key), _mm256_andnot_si256(empty[row], _mm256_set1_epi16(-1)));
+            best = _mm256_min_epu16(best, key);
+        }
+    }
+
+    __m128i half = _mm_min_epu16(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    int key = _mm_extract_epi16(_mm_minpos_epu16(half), 0);
+
+    MrvChoice choice = {-1, size + 1, 0};
+    if (key == 0xFFFF) return choice; // Nenhuma célula vazia
+
+    choice.pos = key & 0xFF;
+    choice.count = key >> 8;
+    int row = choice.pos / size, col = choice.pos % size;
+    choice.candidates = candidates[row][(col / box) * 4 + col % box];
+    return choice;
+}
+
+// Instâncias com box constante, para o compilador desenrolar os laços
+__attribute__((target("avx2")))
+static MrvChoice scan_avx2(const uint8_t *grid, int box) {
+    return box == 3 ? scan_avx2_box(grid, 3) : scan_avx2_box(grid, 4);
+}
+
+#endif
+
+typedef MrvChoice (*ScanFunction)(const uint8_t *grid, int box);
+
+static ScanFunction scan;
+static const char *scan_name;
+
+// Escolhe a implementação uma única vez, pelo CPUID
+static void pick_scan(void) {
+#ifdef HAVE_AVX2_KERNEL
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        scan = scan_avx2;
+        scan_name = "AVX2";
+        return;
+    }
+#endif
+    scan = scan_scalar;
+    scan_name = "escalar";
+}
+
+// Função para escolher a célula da MRV calculando os candidatos da grade inteira
+MrvChoice mrv_scan(const uint8_t *grid, int box) {
+    if (!scan) pick_scan();
+    return scan(grid, box);
+}
+
+// Nome da implementação escolhida ("AVX2" ou "escalar")
+const char *mrv_scan_backend(void) {
+    if (!scan) pick_scan();
+    return scan_name;
+}
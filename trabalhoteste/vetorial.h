@@ -0,0 +1,19 @@
+#ifndef VETORIAL_H
+#define VETORIAL_H
+
+#include <stdint.h>
+
+// Célula escolhida pela MRV em uma varredura da grade inteira
+typedef struct {
+    int pos;              // posição row * size + col, ou -1 se a grade estiver completa
+    int count;            // quantidade de candidatos (0 indica contradição)
+    uint16_t candidates;  // bit (num - 1) ligado para cada número possível
+} MrvChoice;
+
+// Calcula os candidatos de todas as células de uma grade 9x9 (box = 3) ou 16x16 (box = 4)
+// e devolve a célula vazia com menos candidatos (a de menor posição, em caso de empate).
+// Usa AVX2 se o processador tiver (verificado pelo CPUID na primeira chamada) ou a versão escalar.
+MrvChoice mrv_scan(const uint8_t *grid, int box);
+const char *mrv_scan_backend(void);
+
+#endif